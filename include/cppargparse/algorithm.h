@@ -10,6 +10,7 @@
 #include <algorithm>
 
 #include "cmd.h"
+#include "lexer.h"
 
 
 namespace cppargparse {
@@ -20,15 +21,16 @@ namespace algorithm {
  * @brief Find an argument by its ID.
  *
  * @param cmdargs The command line arguments to lookup the argument ID.
- * @param id The argument ID. Can also be the argument's alterinative ID.
+ * @param id The argument ID. Can also be the argument's alterinative ID or, for negatable arguments, a negation like "--no-cache".
  *
  * @return The command line arguments iterator position of the argument.
  */
-cmd::CommandLineArgumentPosition_t find_arg(const cmd::CommandLineArguments_t &cmdargs, const std::string &id)
+inline cmd::CommandLineArgumentPosition_t find_arg(const cmd::CommandLineArguments_t &cmdargs, const std::string_view &id)
 {
     for (auto it = cmdargs.cbegin(); it != cmdargs.cend(); ++it)
     {
-        if (it->id() == id || it->id_alt() == id)
+        if (cmd::is_arg_id(id, it->id(), it->id_alt())
+                || (it->negatable() && (lexer::is_negation(id, it->id()) || lexer::is_negation(id, it->id_alt()))))
         {
             return it;
         }
@@ -41,17 +43,19 @@ cmd::CommandLineArgumentPosition_t find_arg(const cmd::CommandLineArguments_t &c
 /**
  * @brief Find an argument's command line position by its ID.
  *
+ * The scan stops at the "--" terminator, tokens after it are never options.
+ *
  * @param cmd The command line.
  * @param id The argument ID.
  * @param id_alt The argument alternative ID.
  *
  * @return The command line iterator position of the argument.
  */
-cmd::CommandLinePosition_t find_arg_position(const cmd::CommandLine_t &cmd, const std::string &id, const std::string &id_alt)
+inline cmd::CommandLinePosition_t find_arg_position(const cmd::CommandLine_t &cmd, const std::string_view &id, const std::string_view &id_alt)
 {
-    for (auto it = cmd.cbegin(); it != cmd.cend(); ++it)
+    for (auto it = cmd.cbegin(); it != cmd.cend() && *it != lexer::terminator; ++it)
     {
-        if (*it == id || *it == id_alt)
+        if (cmd::is_arg_id(*it, id, id_alt))
         {
             return it;
         }
@@ -61,6 +65,92 @@ cmd::CommandLinePosition_t find_arg_position(const cmd::CommandLine_t &cmd, cons
 }
 
 
+/**
+ * @brief Append the command line positions of every occurrence of an argument before the "--" terminator.
+ *
+ * @param cmd The command line.
+ * @param id The argument ID.
+ * @param id_alt The argument alternative ID.
+ * @param positions The positions to append to, in command line order.
+ */
+inline void find_arg_positions(const cmd::CommandLine_t &cmd, const std::string_view &id, const std::string_view &id_alt, cmd::CommandLinePositions_t &positions)
+{
+    for (auto it = cmd.cbegin(); it != cmd.cend() && *it != lexer::terminator; ++it)
+    {
+        if (cmd::is_arg_id(*it, id, id_alt))
+        {
+            positions.emplace_back(it);
+        }
+    }
+}
+
+
+/**
+ * @brief Append the command line positions of every occurrence of a boolean argument before the "--" terminator,
+ *        including its negations.
+ *
+ * Example: "--cache" also matches "--no-cache".
+ *
+ * @param cmd The command line.
+ * @param id The argument ID.
+ * @param id_alt The argument alternative ID.
+ * @param positions The positions to append to, in command line order.
+ */
+inline void find_negatable_arg_positions(const cmd::CommandLine_t &cmd, const std::string_view &id, const std::string_view &id_alt, cmd::CommandLinePositions_t &positions)
+{
+    for (auto it = cmd.cbegin(); it != cmd.cend() && *it != lexer::terminator; ++it)
+    {
+        if (cmd::is_arg_id(*it, id, id_alt) || lexer::is_negation(*it, id) || lexer::is_negation(*it, id_alt))
+        {
+            positions.emplace_back(it);
+        }
+    }
+}
+
+
+/**
+ * @brief Find the command line positions of every occurrence of an argument before the "--" terminator.
+ *
+ * @param cmd The command line.
+ * @param id The argument ID.
+ * @param id_alt The argument alternative ID.
+ *
+ * @return The command line iterator positions of the argument, in command line order.
+ */
+inline cmd::CommandLinePositions_t find_arg_positions(const cmd::CommandLine_t &cmd, const std::string_view &id, const std::string_view &id_alt)
+{
+    cmd::CommandLinePositions_t positions(cmd.get_allocator());
+    find_arg_positions(cmd, id, id_alt, positions);
+
+    return positions;
+}
+
+
+/**
+ * @brief Find the end of an option's values.
+ *
+ * @param cmd The command line.
+ * @param position The argument iterator position (start position).
+ * @param cmdargs The command line arguments.
+ *
+ * @return The command line position of the next command line argument, the "--" terminator or the end of the command line.
+ */
+inline cmd::CommandLinePosition_t find_option_end(
+        const cmd::CommandLine_t &cmd,
+        const cmd::CommandLinePosition_t &position,
+        const cmd::CommandLineArguments_t &cmdargs)
+{
+    auto current = std::next(position);
+
+    while (current != cmd.cend() && *current != lexer::terminator && find_arg(cmdargs, *current) == cmdargs.cend())
+    {
+        ++current;
+    }
+
+    return current;
+}
+
+
 /**
  * @brief Return command line positions of an argument vector option.
  *
@@ -70,20 +160,18 @@ cmd::CommandLinePosition_t find_arg_position(const cmd::CommandLine_t &cmd, cons
  *
  * @return Command line positions of an argument vector option.
  */
-cmd::CommandLinePositions_t get_option_positions(
+inline cmd::CommandLinePositions_t get_option_positions(
         const cmd::CommandLine_t &cmd,
         const cmd::CommandLinePosition_t &position,
         const cmd::CommandLineArguments_t &cmdargs)
 {
-    cmd::CommandLinePositions_t positions;
+    const auto end = find_option_end(cmd, position, cmdargs);
 
-    for (auto current = std::next(position); current != cmd.end(); ++current)
-    {
-        if (find_arg(cmdargs, *current) != cmdargs.cend())
-        {
-            break;
-        }
+    cmd::CommandLinePositions_t positions(cmd.get_allocator());
+    positions.reserve(static_cast<size_t>(std::distance(position, end)) - 1);
 
+    for (auto current = std::next(position); current != end; ++current)
+    {
         positions.emplace_back(current);
     }
 
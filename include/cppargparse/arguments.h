@@ -8,10 +8,18 @@
 
 
 #include <cppargparse/arguments/argument.h>
+#include <cppargparse/arguments/bool.h>
+#include <cppargparse/arguments/byte_size.h>
 #include <cppargparse/arguments/container.h>
 #include <cppargparse/arguments/double.h>
+#include <cppargparse/arguments/duration.h>
+#include <cppargparse/arguments/enum.h>
 #include <cppargparse/arguments/float.h>
 #include <cppargparse/arguments/int.h>
+#include <cppargparse/arguments/map.h>
+#include <cppargparse/arguments/network.h>
+#include <cppargparse/arguments/path.h>
 #include <cppargparse/arguments/string.h>
+#include <cppargparse/arguments/tuple.h>
 
 #endif // CPPARGPARSE_ARGUMENTS_H
@@ -2,7 +2,11 @@
 #define CPPARGPARSE_ARGUMENTS_ARGUMENT_H
 
 #include <functional>
-#include <sstream>
+#include <iterator>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <type_traits>
 
 #include <cppargparse/cmd.h>
 #include <cppargparse/errors.h>
@@ -21,22 +25,113 @@ namespace cppargparse {
     }
 
 
+template <typename T>
+struct argument;
+
+
 namespace common {
 
 
+template <typename T, typename = void>
+/**
+ * @brief Whether argument<T> names its value type itself with a static type_name() method, e.g. enums.
+ */
+struct has_type_name : std::false_type {};
+
+template <typename T>
+struct has_type_name<T, std::void_t<decltype(argument<T>::type_name())>> : std::true_type {};
+
+
+template <typename T>
+/**
+ * @brief Return the name of a value type for error messages.
+ *
+ * @tparam T The value type.
+ *
+ * @return The type name, a static string.
+ */
+constexpr const char *type_name()
+{
+    constexpr const char *signed_names[] = {"int8_t", "int16_t", "int32_t", "int64_t"};
+    constexpr const char *unsigned_names[] = {"uint8_t", "uint16_t", "uint32_t", "uint64_t"};
+    constexpr size_t size_index = (sizeof(T) == 1) ? 0 : (sizeof(T) == 2) ? 1 : (sizeof(T) == 4) ? 2 : 3;
+
+    if constexpr (std::is_same_v<T, bool>)
+    {
+        return "bool";
+    }
+    else if constexpr (std::is_same_v<T, char>)
+    {
+        return "char";
+    }
+    else if constexpr (std::is_integral_v<T>)
+    {
+        return std::is_signed_v<T> ? signed_names[size_index] : unsigned_names[size_index];
+    }
+    else if constexpr (std::is_same_v<T, float>)
+    {
+        return "float";
+    }
+    else if constexpr (std::is_same_v<T, double>)
+    {
+        return "double";
+    }
+    else if constexpr (std::is_floating_point_v<T>)
+    {
+        return "long double";
+    }
+    else if constexpr (std::is_same_v<T, std::string>)
+    {
+        return "std::string";
+    }
+    else if constexpr (has_type_name<T>::value)
+    {
+        return argument<T>::type_name();
+    }
+    else
+    {
+        return "value";
+    }
+}
+
+
 template <typename T>
 /**
- * @brief Stub error message.
+ * @brief Build the payload of an error for a value that cannot be converted.
+ *
+ * @tparam T The value type.
+ *
+ * @param cmd The command line.
+ * @param position The command line position of the token holding the value.
+ * @param value The value, the whole token or a part of it.
  *
- * @param position The command line position.
- * @return An empty C-style string.
+ * @return The error payload.
  */
-static const char *error_message(const cmd::CommandLinePosition_t &position)
+errors::ErrorPayload conversion_error(const cmd::CommandLine_t &cmd, const cmd::CommandLinePosition_t &position, const std::string_view &value)
 {
-    std::ostringstream message;
-    message << "Couldn't convert " << *position << "to type <" << typeid(T).name() << ">";
+    return errors::make_payload(
+                errors::ErrorCode::InvalidValue,
+                static_cast<size_t>(std::distance(cmd.cbegin(), position)),
+                errors::no_index,
+                type_name<T>(),
+                value);
+}
+
 
-    return message.str().c_str();
+template <typename T>
+/**
+ * @brief Build the payload of an error for a value that is missing or cannot be converted.
+ *
+ * @tparam T The value type.
+ *
+ * @param cmd The command line.
+ * @param position The command line position of the value, cmd.cend() if it is missing.
+ *
+ * @return The error payload.
+ */
+errors::ErrorPayload conversion_error(const cmd::CommandLine_t &cmd, const cmd::CommandLinePosition_t &position)
+{
+    return conversion_error<T>(cmd, position, (position == cmd.cend()) ? std::string_view() : *position);
 }
 
 
@@ -57,6 +152,31 @@ T parse_argument(const cmd::CommandLine_t &cmd, const cmd::CommandLinePosition_t
     return converter(cmd, std::next(position), cmdargs);
 }
 
+template <typename Allocator>
+/**
+ * @brief Create the allocator for a converted container value.
+ *
+ * Polymorphic allocators use the memory resource of the command line, so std::pmr containers
+ * are allocated wherever the parser keeps its command line.
+ *
+ * @tparam Allocator The container allocator type.
+ *
+ * @param cmd The command line.
+ *
+ * @return The container allocator.
+ */
+Allocator make_allocator(const cmd::CommandLine_t &cmd)
+{
+    if constexpr (std::is_constructible_v<Allocator, std::pmr::memory_resource *>)
+    {
+        return Allocator(cmd.get_allocator().resource());
+    }
+    else
+    {
+        return Allocator();
+    }
+}
+
 } // namespace common
 
 
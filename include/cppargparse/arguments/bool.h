@@ -0,0 +1,256 @@
+#ifndef CPPARGPARSE_ARGUMENTS_BOOL_H
+#define CPPARGPARSE_ARGUMENTS_BOOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <string_view>
+
+#include <cppargparse/algorithm.h>
+#include <cppargparse/cmd.h>
+#include <cppargparse/errors.h>
+
+#include "argument.h"
+#include "numerical.h"
+
+
+namespace cppargparse {
+namespace boolean {
+
+
+/**
+ * @brief Pack a word of at most 5 characters into an integer.
+ *
+ * @param word The word.
+ *
+ * @return The length in the top byte and the characters in the low bytes, the first one lowest.
+ */
+constexpr uint64_t pack(const std::string_view &word)
+{
+    uint64_t packed = static_cast<uint64_t>(word.size()) << 56;
+
+    for (size_t i = 0; i < word.size(); ++i)
+    {
+        packed |= static_cast<uint64_t>(static_cast<unsigned char>(word[i])) << (8 * i);
+    }
+
+    return packed;
+}
+
+
+/**
+ * @brief Pack a value for comparison with the packed boolean words, ignoring the case of letters.
+ *
+ * All words longer than one character consist of letters only, so setting bit 5 of every character
+ * folds exactly their upper-case spellings onto the packed lower-case words.
+ *
+ * @param text The value.
+ *
+ * @return The packed lower-cased value, 0 if it is too long or empty to be a boolean word.
+ */
+inline uint64_t pack_folded(const std::string_view &text)
+{
+    if (text.empty() || text.size() > 5)
+    {
+        return 0;
+    }
+
+    const uint64_t case_mask = (text.size() > 1) ? (0x2020202020ull >> (8 * (5 - text.size()))) : 0;
+    return pack(text) | case_mask;
+}
+
+
+/// The packed words meaning true.
+static constexpr uint64_t true_words[] = {pack("1"), pack("on"), pack("yes"), pack("true")};
+
+/// The packed words meaning false.
+static constexpr uint64_t false_words[] = {pack("0"), pack("no"), pack("off"), pack("false")};
+
+/// The packed word meaning neither, for tri-state values.
+static constexpr uint64_t auto_word = pack("auto");
+
+
+/**
+ * @brief Return whether a packed value is one of a list of packed words.
+ *
+ * @param packed The packed value.
+ * @param words The packed words.
+ *
+ * @return Whether the value is one of the words.
+ */
+inline bool matches(const uint64_t packed, const uint64_t (&words)[4])
+{
+    return (packed == words[0]) | (packed == words[1]) | (packed == words[2]) | (packed == words[3]);
+}
+
+
+/**
+ * @brief Convert a boolean word, "true", "yes", "on" and "1" or "false", "no", "off" and "0", ignoring case.
+ *
+ * @param text The word.
+ * @param value The boolean value of the word.
+ *
+ * @return Whether the text is a boolean word.
+ */
+static bool parse_bool(const std::string_view &text, bool &value)
+{
+    const uint64_t packed = pack_folded(text);
+    const bool is_true = matches(packed, true_words);
+
+    if (!is_true && !matches(packed, false_words))
+    {
+        return false;
+    }
+
+    value = is_true;
+    return true;
+}
+
+
+/**
+ * @brief Convert a tri-state word, a boolean word or "auto", ignoring case.
+ *
+ * @param text The word.
+ * @param value The value of the word, std::nullopt for "auto".
+ *
+ * @return Whether the text is a tri-state word.
+ */
+static bool parse_tristate(const std::string_view &text, std::optional<bool> &value)
+{
+    bool boolean = false;
+
+    if (parse_bool(text, boolean))
+    {
+        value = boolean;
+        return true;
+    }
+
+    if (pack_folded(text) != auto_word)
+    {
+        return false;
+    }
+
+    value = std::nullopt;
+    return true;
+}
+
+
+template <typename T>
+/**
+ * @brief Parse the value of a boolean option.
+ *
+ * "--no-foo" is false. "--foo" is followed by an optional value, e.g. "--foo=no" or "--foo off".
+ * Without one it is true, and a following token that isn't a value is left alone.
+ *
+ * @tparam T bool or std::optional<bool>.
+ * @param cmd The command line.
+ * @param position The command line position of the option.
+ * @param cmdargs The command line arguments.
+ * @param converter The value converter.
+ *
+ * @return The value of the option.
+ */
+T parse_switch(
+        const cmd::CommandLine_t &cmd,
+        const cmd::CommandLinePosition_t &position,
+        const cmd::CommandLineArguments_t &cmdargs,
+        bool (*converter)(const std::string_view &, T &))
+{
+    // Negations are the only occurrences of a registered argument that aren't one of its IDs
+    const auto cmdarg = algorithm::find_arg(cmdargs, *position);
+
+    if (cmdarg != cmdargs.cend() && *position != cmdarg->id() && *position != cmdarg->id_alt())
+    {
+        return T(false);
+    }
+
+    const auto next = std::next(position);
+    T value {};
+
+    if (next != cmd.cend() && algorithm::find_arg(cmdargs, *next) == cmdargs.cend() && converter(*next, value))
+    {
+        return value;
+    }
+
+    return T(true);
+}
+
+
+} // namespace boolean
+
+
+template <>
+/**
+ * @brief The argument struct for the bool type.
+ *
+ * Options registered with add_bool() also accept their negation, e.g. "--no-cache" for "--cache".
+ */
+struct argument<bool>
+{
+    /**
+     * @brief Parse a boolean option.
+     *
+     * @param cmd The command line.
+     * @param position The command line position of the option.
+     * @param cmdargs The command line arguments.
+     *
+     * @return false for "--no-foo", the value of "--foo <value>" or true for a bare "--foo".
+     */
+    static bool parse(
+            const cmd::CommandLine_t &cmd,
+            const cmd::CommandLinePosition_t &position,
+            const cmd::CommandLineArguments_t &cmdargs)
+    {
+        return boolean::parse_switch<bool>(cmd, position, cmdargs, &boolean::parse_bool);
+    }
+
+
+    CPPARGPARSE_NUMERICAL_CONVERT(bool, boolean::parse_bool)
+};
+
+
+template <>
+/**
+ * @brief The argument struct for tri-state values: true, false or "auto" (std::nullopt).
+ *
+ * Options registered with add_bool() also accept their negation, e.g. "--no-color" for "--color".
+ */
+struct argument<std::optional<bool>>
+{
+    /**
+     * @brief Parse a tri-state option.
+     *
+     * @param cmd The command line.
+     * @param position The command line position of the option.
+     * @param cmdargs The command line arguments.
+     *
+     * @return false for "--no-foo", the value of "--foo <value>" or true for a bare "--foo".
+     */
+    static std::optional<bool> parse(
+            const cmd::CommandLine_t &cmd,
+            const cmd::CommandLinePosition_t &position,
+            const cmd::CommandLineArguments_t &cmdargs)
+    {
+        return boolean::parse_switch<std::optional<bool>>(cmd, position, cmdargs, &boolean::parse_tristate);
+    }
+
+
+    CPPARGPARSE_NUMERICAL_CONVERT(std::optional<bool>, boolean::parse_tristate)
+
+
+    /**
+     * @brief Return the name of the value type for error messages.
+     *
+     * @return The type name.
+     */
+    static constexpr const char *type_name()
+    {
+        return "std::optional<bool>";
+    }
+};
+
+
+} // namespace cppargparse
+
+#endif // CPPARGPARSE_ARGUMENTS_BOOL_H
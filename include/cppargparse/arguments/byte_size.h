@@ -0,0 +1,53 @@
+#ifndef CPPARGPARSE_ARGUMENTS_BYTE_SIZE_H
+#define CPPARGPARSE_ARGUMENTS_BYTE_SIZE_H
+
+#include <cppargparse/cmd.h>
+
+#include "argument.h"
+#include "container.h"
+#include "numerical.h"
+#include "units.h"
+
+
+namespace cppargparse {
+
+
+template <>
+/**
+ * @brief The argument struct for byte sizes, e.g. "--cache-size 4GiB".
+ *
+ * Accepts a magnitude with an optional fractional part and SI or IEC units, see parse_byte_size().
+ */
+struct argument<units::ByteSize>
+{
+    CPPARGPARSE_PARSE_ARGUMENT(units::ByteSize)
+
+    CPPARGPARSE_NUMERICAL_CONVERT(units::ByteSize, parse_byte_size)
+
+
+    /**
+     * @brief Return the name of the value type for error messages.
+     *
+     * @return The type name.
+     */
+    static constexpr const char *type_name()
+    {
+        return "byte size";
+    }
+};
+
+
+template <>
+/**
+ * @brief Byte sizes are separated by ',' inside a single token, e.g. "--buffers 4KiB,64KiB".
+ */
+struct list_delimiter<units::ByteSize>
+{
+    /// The delimiter.
+    static constexpr char value = ',';
+};
+
+
+} // namespace cppargparse
+
+#endif // CPPARGPARSE_ARGUMENTS_BYTE_SIZE_H
@@ -1,42 +1,559 @@
 #ifndef CPPARGPARSE_ARGUMENTS_CONTAINER_H
 #define CPPARGPARSE_ARGUMENTS_CONTAINER_H
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <deque>
+#include <iterator>
 #include <list>
+#include <memory>
+#include <set>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include <cppargparse/algorithm.h>
 #include <cppargparse/cmd.h>
+#include <cppargparse/errors.h>
+#include <cppargparse/lexer.h>
+#include <cppargparse/parallel.h>
+#include <cppargparse/split.h>
 
 #include "argument.h"
 
 
-#define CPPARGPARSE_CONTAINER_ARGUMENT(container_type) \
-template <typename T> \
-struct argument<container_type<T>> { \
-\
-    static const container_type<T> parse( \
-            const cmd::CommandLine_t &cmd, \
-            const cmd::CommandLinePosition_t &position, \
-            const cmd::CommandLineArguments_t &cmdargs) \
-    { \
-        auto positions = algorithm::get_option_positions(cmd, position, cmdargs); \
-        container_type<T> values; \
-\
-        for (auto position : positions) \
-        { \
-            values.emplace_back(argument<T>::convert(cmd, position, cmdargs)); \
-        } \
-\
-        return values; \
-    } \
+namespace cppargparse {
+
+
+template <typename T>
+/**
+ * @brief The delimiter separating several values of type T inside a single command line token.
+ *
+ * Container arguments accept "--weights 0.1,0.2 0.3" as well as "--weights=0.1,0.2,0.3".
+ * Multi-byte arithmetic types use ',', all other types '\0' (no splitting).
+ * Specialize it to change the delimiter of a value type:
+ *
+ *     template <>
+ *     struct list_delimiter<std::string>
+ *     {
+ *         static constexpr char value = ':';
+ *     };
+ *
+ * @tparam T The container value type.
+ */
+struct list_delimiter
+{
+    /// The delimiter, '\0' if tokens are never split.
+    static constexpr char value = (std::is_arithmetic_v<T> && sizeof(T) > 1) ? ',' : '\0';
+};
+
+
+namespace common {
+
+
+template <typename T, typename = void>
+/**
+ * @brief Whether argument<T> converts values from plain strings with convert_value(), e.g. numerical types and std::string.
+ */
+struct has_convert_value : std::false_type {};
+
+template <typename T>
+struct has_convert_value<T, std::void_t<decltype(&argument<T>::convert_value)>> : std::true_type {};
+
+
+template <typename T, typename = void>
+/**
+ * @brief Whether argument<T>::convert_value() queries the system, declared by a static constexpr bool validates_values.
+ *
+ * Such values are split across threads by #cppargparse::parallel::validation_policy().
+ */
+struct validates_values : std::false_type {};
+
+template <typename T>
+struct validates_values<T, std::enable_if_t<argument<T>::validates_values>> : std::true_type {};
+
+
+template <typename Container, typename = void>
+/**
+ * @brief Whether a container stores its values contiguously, accessible through data().
+ */
+struct has_contiguous_storage : std::false_type {};
+
+template <typename Container>
+struct has_contiguous_storage<Container, std::void_t<decltype(std::declval<Container &>().data())>> : std::true_type {};
+
+
+template <typename T>
+/**
+ * @brief Count the values of type T in a range of command line tokens.
+ *
+ * @param first The command line position of the first token.
+ * @param last The command line position past the last token.
+ *
+ * @return The number of values, counting every delimiter-separated value.
+ */
+size_t count_values(const cmd::CommandLinePosition_t &first, const cmd::CommandLinePosition_t &last)
+{
+    size_t count = static_cast<size_t>(std::distance(first, last));
+
+    if constexpr (list_delimiter<T>::value != '\0')
+    {
+        for (auto current = first; current != last; ++current)
+        {
+            count += split::count(*current, list_delimiter<T>::value);
+        }
+    }
+
+    return count;
 }
 
 
-namespace cppargparse {
+template <typename T>
+/**
+ * @brief Convert a single value, the whole command line token or a delimiter-separated part of it.
+ *
+ * @tparam T The value type.
+ *
+ * @param cmd The command line.
+ * @param position The command line position of the token holding the value.
+ * @param value The value.
+ * @param cmdargs The command line arguments.
+ *
+ * @return The converted value.
+ * @throws #cppargparse::errors::CommandLineOptionError if the conversion was unsuccessful.
+ */
+T convert_value(
+        const cmd::CommandLine_t &cmd,
+        const cmd::CommandLinePosition_t &position,
+        const std::string_view &value,
+        const cmd::CommandLineArguments_t &cmdargs)
+{
+    T converted {};
+
+    if constexpr (has_convert_value<T>::value)
+    {
+        if (!argument<T>::convert_value(value, converted))
+        {
+            errors::raise<errors::CommandLineOptionError>(conversion_error<T>(cmd, position, value));
+            return T();
+        }
+    }
+    else if (value.size() == position->size())
+    {
+        return argument<T>::convert(cmd, position, cmdargs);
+    }
+    else
+    {
+        // Converters read command line positions, so the value gets a command line of its own
+        const cmd::CommandLine_t value_cmd(1, value, cmd.get_allocator());
+
+        if (errors::capture([&]() { converted = argument<T>::convert(value_cmd, value_cmd.cbegin(), cmdargs); }) != errors::ErrorCode::None)
+        {
+            errors::raise<errors::CommandLineOptionError>(conversion_error<T>(cmd, position, value));
+            return T();
+        }
+    }
+
+    return converted;
+}
+
+
+template <typename T>
+/**
+ * @brief Convert the values of a range of command line tokens into pre-sized storage without raising errors.
+ *
+ * Values that can't be converted are left at T() and the conversion carries on.
+ *
+ * @tparam T The value type. argument<T>::convert_value() must be implemented for T.
+ *
+ * @param first The command line position of the first token.
+ * @param last The command line position past the last token.
+ * @param values The storage for count_values<T>(first, last) values.
+ * @param failure The command line position of the token holding the first bad value, unchanged if there is none.
+ * @param failed_value The first bad value.
+ *
+ * @return Whether all values could be converted.
+ */
+bool convert_chunk(
+        const cmd::CommandLinePosition_t &first,
+        const cmd::CommandLinePosition_t &last,
+        T *values,
+        cmd::CommandLinePosition_t &failure,
+        std::string_view &failed_value)
+{
+    bool converted = true;
+
+    for (auto current = first; current != last; ++current)
+    {
+        split::for_each(*current, list_delimiter<T>::value, [&](const std::string_view &value)
+        {
+            if (!argument<T>::convert_value(value, *values) && converted)
+            {
+                converted = false;
+                failure = current;
+                failed_value = value;
+            }
+
+            ++values;
+        });
+    }
+
+    return converted;
+}
+
+
+template <typename T>
+/**
+ * @brief Convert the values of a range of command line tokens into pre-sized storage.
+ *
+ * Values that can't be converted are set to T() and the conversion carries on,
+ * so only the first bad value is reported.
+ *
+ * Ranges of at least two chunks of #cppargparse::parallel::ConversionPolicy::min_chunk_size tokens
+ * are converted concurrently, see #cppargparse::parallel::set_conversion_policy(),
+ * or #cppargparse::parallel::set_validation_policy() for types with validates_values.
+ * The reported value is the same as with sequential conversion.
+ *
+ * @tparam T The value type. argument<T>::convert_value() must be implemented for T.
+ *
+ * @param cmd The command line.
+ * @param first The command line position of the first token.
+ * @param last The command line position past the last token.
+ * @param values The storage for count_values<T>(first, last) values.
+ *
+ * @throws #cppargparse::errors::CommandLineOptionError if a value cannot be converted.
+ */
+void convert_values(const cmd::CommandLine_t &cmd, const cmd::CommandLinePosition_t &first, const cmd::CommandLinePosition_t &last, T *values)
+{
+    const size_t tokens = static_cast<size_t>(std::distance(first, last));
+    const size_t chunks = parallel::chunk_count(tokens, validates_values<T>::value ? parallel::validation_policy() : parallel::conversion_policy());
+
+    auto failure = last;
+    std::string_view failed_value;
+
+    if (chunks == 1)
+    {
+        convert_chunk<T>(first, last, values, failure, failed_value);
+    }
+    else
+    {
+        // Chunk i converts the tokens [bounds[i], bounds[i + 1]) into values + offsets[i]
+        std::vector<cmd::CommandLinePosition_t> bounds(chunks + 1, last);
+        std::vector<size_t> offsets(chunks, 0);
+
+        for (size_t chunk = 0; chunk < chunks; ++chunk)
+        {
+            bounds[chunk] = std::next(first, static_cast<std::ptrdiff_t>(tokens * chunk / chunks));
+        }
+
+        for (size_t chunk = 1; chunk < chunks; ++chunk)
+        {
+            offsets[chunk] = offsets[chunk - 1] + count_values<T>(bounds[chunk - 1], bounds[chunk]);
+        }
+
+        std::vector<cmd::CommandLinePosition_t> failures(chunks, last);
+        std::vector<std::string_view> failed_values(chunks);
+
+        parallel::for_each_chunk(chunks, [&](const size_t chunk)
+        {
+            convert_chunk<T>(bounds[chunk], bounds[chunk + 1], values + offsets[chunk], failures[chunk], failed_values[chunk]);
+        });
+
+        // The first failing chunk holds the first bad value
+        const auto chunk = static_cast<size_t>(std::distance(failures.cbegin(),
+                    std::find_if(failures.cbegin(), failures.cend(), [&](const auto &position) { return position != last; })));
+
+        if (chunk != chunks)
+        {
+            failure = failures[chunk];
+            failed_value = failed_values[chunk];
+        }
+    }
+
+    if (failure != last)
+    {
+        errors::raise<errors::CommandLineOptionError>(conversion_error<T>(cmd, failure, failed_value));
+    }
+}
+
+
+template <typename Container, typename = void>
+/**
+ * @brief Whether a container can reserve capacity up front, e.g. std::vector and std::unordered_set.
+ */
+struct has_reserve : std::false_type {};
+
+template <typename Container>
+struct has_reserve<Container, std::void_t<decltype(std::declval<Container &>().reserve(size_t()))>> : std::true_type {};
+
+
+template <typename Container, typename = void>
+/**
+ * @brief Whether a container appends values with emplace_back(), as opposed to inserting them with insert().
+ */
+struct has_emplace_back : std::false_type {};
+
+template <typename Container>
+struct has_emplace_back<Container, std::void_t<decltype(std::declval<Container &>().emplace_back(
+        std::declval<typename Container::value_type &&>()))>> : std::true_type {};
+
+
+template <typename Container>
+/**
+ * @brief Move a value into a container, at the end of sequences.
+ *
+ * @param values The container.
+ * @param value The value.
+ */
+void insert_value(Container &values, typename Container::value_type &&value)
+{
+    if constexpr (has_emplace_back<Container>::value)
+    {
+        values.emplace_back(std::move(value));
+    }
+    else
+    {
+        values.insert(std::move(value));
+    }
+}
+
+
+template <typename Container>
+/**
+ * @brief The argument struct implementation for containers collecting every value of an option.
+ *
+ * Works for any container with an allocator constructor and either emplace_back() or insert(),
+ * optionally reserve(). Capacity for all values is reserved up front and every value is moved in.
+ * Values with convert_value() are converted in bulk, reporting only the first value that can't be converted:
+ * directly into contiguous containers, through one buffer into all others.
+ * Everything else is converted value by value.
+ *
+ * Other containers are supported by deriving their argument struct from it:
+ *
+ *     template <typename T>
+ *     struct argument<SmallVector<T>> : common::container_argument<SmallVector<T>> {};
+ *
+ * @tparam Container The container type.
+ */
+struct container_argument
+{
+    /// The value type.
+    typedef typename Container::value_type T;
+
+
+    /**
+     * @brief Parse the values of an option into a container.
+     *
+     * @param cmd The command line.
+     * @param position The command line position of the option.
+     * @param cmdargs The command line arguments.
+     *
+     * @return The container of converted values.
+     * @throws #cppargparse::errors::CommandLineOptionError if a value cannot be converted.
+     */
+    static const Container parse(
+            const cmd::CommandLine_t &cmd,
+            const cmd::CommandLinePosition_t &position,
+            const cmd::CommandLineArguments_t &cmdargs)
+    {
+        const auto first = std::next(position);
+        const auto last = algorithm::find_option_end(cmd, position, cmdargs);
+        Container values(make_allocator<typename Container::allocator_type>(cmd));
+
+        if constexpr (has_convert_value<T>::value && has_contiguous_storage<Container>::value)
+        {
+            values.resize(count_values<T>(first, last));
+            convert_values<T>(cmd, first, last, values.data());
+        }
+        else if constexpr (has_convert_value<T>::value)
+        {
+            // Not a std::vector, which has no data() for bool
+            const size_t count = count_values<T>(first, last);
+            const std::unique_ptr<T[]> converted(new T[count]());
+            convert_values<T>(cmd, first, last, converted.get());
+
+            if constexpr (has_reserve<Container>::value)
+            {
+                values.reserve(count);
+            }
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                insert_value(values, std::move(converted[i]));
+            }
+        }
+        else
+        {
+            if constexpr (has_reserve<Container>::value)
+            {
+                values.reserve(count_values<T>(first, last));
+            }
+
+            for (auto current = first; current != last; ++current)
+            {
+                split::for_each(*current, list_delimiter<T>::value, [&](const std::string_view &value)
+                {
+                    insert_value(values, convert_value<T>(cmd, current, value, cmdargs));
+                });
+            }
+        }
+
+        return values;
+    }
+};
+
+
+} // namespace common
+
+
+template <typename T, typename Allocator>
+/**
+ * @brief The argument struct for std::deque.
+ */
+struct argument<std::deque<T, Allocator>> : common::container_argument<std::deque<T, Allocator>> {};
+
+
+template <typename T, typename Allocator>
+/**
+ * @brief The argument struct for std::list.
+ */
+struct argument<std::list<T, Allocator>> : common::container_argument<std::list<T, Allocator>> {};
+
+
+template <typename T, typename Allocator>
+/**
+ * @brief The argument struct for std::vector.
+ */
+struct argument<std::vector<T, Allocator>> : common::container_argument<std::vector<T, Allocator>> {};
+
+
+template <typename T, typename Compare, typename Allocator>
+/**
+ * @brief The argument struct for std::set. Repeated values are kept once.
+ */
+struct argument<std::set<T, Compare, Allocator>> : common::container_argument<std::set<T, Compare, Allocator>> {};
+
+
+template <typename T, typename Hash, typename KeyEqual, typename Allocator>
+/**
+ * @brief The argument struct for std::unordered_set. Repeated values are kept once.
+ */
+struct argument<std::unordered_set<T, Hash, KeyEqual, Allocator>> : common::container_argument<std::unordered_set<T, Hash, KeyEqual, Allocator>> {};
+
+
+template <typename CharT, typename Traits, typename Allocator>
+/**
+ * @brief The argument struct for strings of other character types, e.g. std::basic_string<unsigned char> from "--keys 1 2 255".
+ *
+ * Every value is an element of its own, converted like the character type, so signed and unsigned char
+ * read 8-bit integers. Strings of char are single values, see string.h.
+ */
+struct argument<std::basic_string<CharT, Traits, Allocator>> : common::container_argument<std::basic_string<CharT, Traits, Allocator>> {};
+
+
+template <typename T, size_t N>
+/**
+ * @brief The argument struct for fixed-size arrays.
+ *
+ * Consumes exactly the tokens holding the N values, e.g. "--origin 1 2 3" or "--origin 1,2,3"
+ * for std::array<int, 3>. Tokens after them are left alone, even if they aren't registered arguments.
+ * Like other containers, the values end at the next registered argument or the "--" terminator.
+ *
+ * @tparam T The value type.
+ * @tparam N The number of values.
+ */
+struct argument<std::array<T, N>>
+{
+    /**
+     * @brief Parse the values of an option into an array.
+     *
+     * @param cmd The command line.
+     * @param position The command line position of the option.
+     * @param cmdargs The command line arguments.
+     *
+     * @return The array of converted values.
+     * @throws #cppargparse::errors::CommandLineOptionError if there aren't exactly N values or one cannot be converted.
+     */
+    static const std::array<T, N> parse(
+            const cmd::CommandLine_t &cmd,
+            const cmd::CommandLinePosition_t &position,
+            const cmd::CommandLineArguments_t &cmdargs)
+    {
+        return convert_range(cmd, std::next(position), algorithm::find_option_end(cmd, position, cmdargs), cmdargs);
+    }
+
+
+    /**
+     * @brief Convert the next N values into an array.
+     *
+     * @param cmd The command line.
+     * @param position The command line position of the first value.
+     * @param cmdargs The command line arguments.
+     *
+     * @return The array of converted values.
+     * @throws #cppargparse::errors::CommandLineOptionError if there aren't exactly N values or one cannot be converted.
+     */
+    static const std::array<T, N> convert(
+            const cmd::CommandLine_t &cmd,
+            const cmd::CommandLinePosition_t &position,
+            const cmd::CommandLineArguments_t &cmdargs)
+    {
+        const bool is_value = position != cmd.cend() && *position != lexer::terminator
+                && algorithm::find_arg(cmdargs, *position) == cmdargs.cend();
+
+        return convert_range(cmd, position, is_value ? algorithm::find_option_end(cmd, position, cmdargs) : position, cmdargs);
+    }
+
+
+    /**
+     * @brief Convert the first N values of a range of command line tokens into an array.
+     *
+     * @param cmd The command line.
+     * @param first The command line position of the first value.
+     * @param last The command line position past the last token that may hold values.
+     * @param cmdargs The command line arguments.
+     *
+     * @return The array of converted values.
+     * @throws #cppargparse::errors::CommandLineOptionError if the range holds less than N values,
+     *         a token holds more values than remain or a value cannot be converted.
+     */
+    static const std::array<T, N> convert_range(
+            const cmd::CommandLine_t &cmd,
+            const cmd::CommandLinePosition_t &first,
+            const cmd::CommandLinePosition_t &last,
+            const cmd::CommandLineArguments_t &cmdargs)
+    {
+        std::array<T, N> values {};
+        size_t count = 0;
+
+        auto current = first;
+
+        for (; count < N && current != last; ++current)
+        {
+            if (count + common::count_values<T>(current, std::next(current)) > N)
+            {
+                errors::raise<errors::CommandLineOptionError>(common::conversion_error<T>(cmd, current));
+                return values;
+            }
+
+            split::for_each(*current, list_delimiter<T>::value, [&](const std::string_view &value)
+            {
+                values[count++] = common::convert_value<T>(cmd, current, value, cmdargs);
+            });
+        }
 
+        if (count < N)
+        {
+            errors::raise<errors::CommandLineOptionError>(common::conversion_error<T>(cmd, current));
+        }
 
-CPPARGPARSE_CONTAINER_ARGUMENT(std::list);
-CPPARGPARSE_CONTAINER_ARGUMENT(std::vector);
+        return values;
+    }
+};
 
 
 } // namespace cppargparse
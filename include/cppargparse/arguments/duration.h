@@ -0,0 +1,60 @@
+#ifndef CPPARGPARSE_ARGUMENTS_DURATION_H
+#define CPPARGPARSE_ARGUMENTS_DURATION_H
+
+#include <chrono>
+
+#include <cppargparse/cmd.h>
+
+#include "argument.h"
+#include "container.h"
+#include "numerical.h"
+#include "units.h"
+
+
+namespace cppargparse {
+
+
+template <typename Rep, typename Period>
+/**
+ * @brief The argument struct for std::chrono::duration types, e.g. "--timeout 250ms".
+ *
+ * Accepts a magnitude with an optional fractional part and the units "ns", "us", "ms", "s", "m", "h" and "d",
+ * see parse_duration().
+ */
+struct argument<std::chrono::duration<Rep, Period>>
+{
+    /// The duration type.
+    typedef std::chrono::duration<Rep, Period> duration_type;
+
+
+    CPPARGPARSE_PARSE_ARGUMENT(duration_type)
+
+    CPPARGPARSE_NUMERICAL_CONVERT(duration_type, parse_duration<duration_type>)
+
+
+    /**
+     * @brief Return the name of the value type for error messages.
+     *
+     * @return The type name.
+     */
+    static constexpr const char *type_name()
+    {
+        return "duration";
+    }
+};
+
+
+template <typename Rep, typename Period>
+/**
+ * @brief Durations are separated by ',' inside a single token, e.g. "--retries 1s,2s,5s".
+ */
+struct list_delimiter<std::chrono::duration<Rep, Period>>
+{
+    /// The delimiter.
+    static constexpr char value = ',';
+};
+
+
+} // namespace cppargparse
+
+#endif // CPPARGPARSE_ARGUMENTS_DURATION_H
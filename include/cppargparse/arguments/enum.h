@@ -0,0 +1,354 @@
+#ifndef CPPARGPARSE_ARGUMENTS_ENUM_H
+#define CPPARGPARSE_ARGUMENTS_ENUM_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string_view>
+
+#include <cppargparse/cmd.h>
+#include <cppargparse/errors.h>
+
+#include "argument.h"
+#include "numerical.h"
+
+
+namespace cppargparse {
+
+
+template <typename E>
+/**
+ * @brief A command line name of an enum value.
+ *
+ * @tparam E The enum type.
+ */
+struct EnumName
+{
+    /// The name, e.g. "fast".
+    std::string_view name;
+
+    /// The enum value.
+    E value;
+};
+
+
+template <typename E>
+/**
+ * @brief The command line names of the values of an enum type.
+ *
+ * Specialized by #CPPARGPARSE_ENUM_ARGUMENT, providing a static constexpr array of #EnumName values.
+ *
+ * @tparam E The enum type.
+ */
+struct enum_names;
+
+
+namespace enumeration {
+
+
+/**
+ * @brief A perfect hash function for a set of names, mapping every name to a slot of its own.
+ */
+struct PerfectHash
+{
+    /// The seed of hash().
+    uint64_t seed;
+
+    /// The number of slots, a power of two. 0 if the names aren't unique.
+    size_t slots;
+};
+
+
+/**
+ * @brief Hash a name.
+ *
+ * @param name The name.
+ * @param seed The seed.
+ *
+ * @return The hash of the name, the slot being its low bits.
+ */
+constexpr uint64_t hash(const std::string_view &name, const uint64_t seed)
+{
+    // FNV-1a, with the high bits folded into the low bits picking the slot
+    uint64_t h = 0xcbf29ce484222325ull ^ (seed * 0x9e3779b97f4a7c15ull);
+
+    for (const char c : name)
+    {
+        h = (h ^ static_cast<unsigned char>(c)) * 0x100000001b3ull;
+    }
+
+    return h ^ (h >> 29) ^ (h >> 47);
+}
+
+
+template <typename E>
+/**
+ * @brief Return the number of names of an enum type.
+ *
+ * @tparam E The enum type.
+ *
+ * @return The number of names.
+ */
+constexpr size_t name_count()
+{
+    return std::size(enum_names<E>::values);
+}
+
+
+template <typename E>
+/**
+ * @brief Search a seed and the smallest table mapping every name of an enum type to a slot of its own.
+ *
+ * Runs at compile time. Tables start at twice the number of names and double
+ * whenever 256 seeds don't separate all names.
+ *
+ * @tparam E The enum type.
+ *
+ * @return The perfect hash function, with 0 slots if some names are equal.
+ */
+constexpr PerfectHash find_perfect_hash()
+{
+    constexpr size_t count = name_count<E>();
+    const auto &names = enum_names<E>::values;
+
+    size_t slots = 2;
+
+    while (slots < count * 2)
+    {
+        slots *= 2;
+    }
+
+    for (; slots <= count * 256; slots *= 2)
+    {
+        for (uint64_t seed = 0; seed < 256; ++seed)
+        {
+            std::array<size_t, count> used {};
+            bool separated = true;
+
+            for (size_t i = 0; i < count && separated; ++i)
+            {
+                used[i] = static_cast<size_t>(hash(names[i].name, seed)) & (slots - 1);
+
+                for (size_t j = 0; j < i && separated; ++j)
+                {
+                    separated = (used[i] != used[j]);
+                }
+            }
+
+            if (separated)
+            {
+                return PerfectHash { seed, slots };
+            }
+        }
+    }
+
+    return PerfectHash { 0, 0 };
+}
+
+
+template <typename E>
+/// The perfect hash function of the names of E.
+static constexpr PerfectHash perfect_hash = find_perfect_hash<E>();
+
+
+template <typename E>
+/**
+ * @brief Build the slot table of the names of an enum type.
+ *
+ * @tparam E The enum type.
+ *
+ * @return The slots, holding 1 + the index of their name or 0 if unused.
+ */
+constexpr std::array<size_t, perfect_hash<E>.slots> make_slots()
+{
+    static_assert(perfect_hash<E>.slots != 0, "The names of an enum argument must be unique");
+
+    std::array<size_t, perfect_hash<E>.slots> slots {};
+    const auto &names = enum_names<E>::values;
+
+    for (size_t i = 0; i < name_count<E>(); ++i)
+    {
+        slots[static_cast<size_t>(hash(names[i].name, perfect_hash<E>.seed)) & (slots.size() - 1)] = i + 1;
+    }
+
+    return slots;
+}
+
+
+template <typename E>
+/// The slot table of the names of E.
+static constexpr std::array<size_t, perfect_hash<E>.slots> slots = make_slots<E>();
+
+
+template <typename E>
+/**
+ * @brief Return the length of the list of names of an enum type.
+ *
+ * @tparam E The enum type.
+ *
+ * @return The length of "name|name|...", including the terminating null character.
+ */
+constexpr size_t choices_size()
+{
+    size_t size = 0;
+
+    for (const auto &entry : enum_names<E>::values)
+    {
+        size += entry.name.size() + 1;
+    }
+
+    return size;
+}
+
+
+template <typename E>
+/**
+ * @brief Build the list of names of an enum type.
+ *
+ * @tparam E The enum type.
+ *
+ * @return The null-terminated names, separated by '|', e.g. "fast|safe|debug".
+ */
+constexpr std::array<char, choices_size<E>()> make_choices()
+{
+    std::array<char, choices_size<E>()> choices {};
+    size_t size = 0;
+
+    for (const auto &entry : enum_names<E>::values)
+    {
+        if (size != 0)
+        {
+            choices[size++] = '|';
+        }
+
+        for (const char c : entry.name)
+        {
+            choices[size++] = c;
+        }
+    }
+
+    return choices;
+}
+
+
+template <typename E>
+/// The null-terminated names of E, separated by '|'.
+static constexpr std::array<char, choices_size<E>()> choices = make_choices<E>();
+
+
+template <typename E>
+/**
+ * @brief Look up the enum value of a name.
+ *
+ * Hashes the name once and compares it with the single name sharing its slot,
+ * no matter how many names there are.
+ *
+ * @tparam E The enum type.
+ * @param name The name.
+ * @param value The enum value of the name.
+ *
+ * @return Whether the name is one of the names of E.
+ */
+static bool find(const std::string_view &name, E &value)
+{
+    const size_t slot = slots<E>[static_cast<size_t>(hash(name, perfect_hash<E>.seed)) & (slots<E>.size() - 1)];
+
+    if (slot == 0 || enum_names<E>::values[slot - 1].name != name)
+    {
+        return false;
+    }
+
+    value = enum_names<E>::values[slot - 1].value;
+    return true;
+}
+
+
+} // namespace enumeration
+
+
+namespace common {
+
+
+template <typename E>
+/**
+ * @brief The argument struct implementation for enums with a name table, see #CPPARGPARSE_ENUM_ARGUMENT.
+ *
+ * @tparam E The enum type.
+ */
+struct enum_argument
+{
+    CPPARGPARSE_PARSE_ARGUMENT(E)
+
+
+    /**
+     * @brief Try to convert a command line argument to an enum value.
+     *
+     * @param cmd The command line.
+     * @param position The command line argument iterator.
+     * @param cmdargs The command line arguments.
+     *
+     * @return The enum value of the command line argument.
+     * @throws #cppargparse::errors::CommandLineOptionError if the value is missing or not one of the names.
+     */
+    static E convert(
+            const cmd::CommandLine_t &cmd,
+            const cmd::CommandLinePosition_t &position,
+            const cmd::CommandLineArguments_t &cmdargs)
+    {
+        return numerical_argument<E>::convert(cmd, position, cmdargs, &enumeration::find<E>);
+    }
+
+
+    /**
+     * @brief Convert a name to an enum value.
+     *
+     * @param text The name.
+     * @param value The enum value.
+     *
+     * @return Whether the name is one of the names of E.
+     */
+    static bool convert_value(const std::string_view &text, E &value)
+    {
+        return enumeration::find<E>(text, value);
+    }
+
+
+    /**
+     * @brief Return the allowed names, used as the type name in error messages.
+     *
+     * @return The names separated by '|', e.g. "fast|safe|debug".
+     */
+    static constexpr const char *type_name()
+    {
+        return enumeration::choices<E>.data();
+    }
+};
+
+
+} // namespace common
+} // namespace cppargparse
+
+
+/*
+ * Declare the command line names of an enum type, at global scope:
+ *
+ *     CPPARGPARSE_ENUM_ARGUMENT(Mode, {"fast", Mode::Fast}, {"safe", Mode::Safe}, {"debug", Mode::Debug});
+ *
+ * The names are mapped to values by a perfect hash function found at compile time.
+ */
+#define CPPARGPARSE_ENUM_ARGUMENT(type, ...) \
+namespace cppargparse { \
+template <> \
+struct enum_names<type> \
+{ \
+    static constexpr EnumName<type> values[] = { __VA_ARGS__ }; \
+}; \
+\
+template <> \
+struct argument<type> : common::enum_argument<type> {}; \
+} \
+static_assert(true, "")
+
+
+#endif // CPPARGPARSE_ARGUMENTS_ENUM_H
@@ -0,0 +1,342 @@
+#ifndef CPPARGPARSE_ARGUMENTS_FLOATING_POINT_H
+#define CPPARGPARSE_ARGUMENTS_FLOATING_POINT_H
+
+#include <algorithm>
+#include <array>
+#include <cfloat>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <string_view>
+#include <type_traits>
+
+#include <charconv>
+
+#if !defined(__cpp_lib_to_chars)
+#include <cctype>
+#include <cerrno>
+#include <string>
+#endif
+
+
+namespace cppargparse {
+namespace floating_point {
+
+
+/// The maximum number of significant decimal digits that fit into the 64-bit mantissa accumulator.
+static constexpr int max_mantissa_digits = 19;
+
+
+template <typename T>
+/**
+ * @brief Return the largest power of 10 that is exactly representable in T.
+ *
+ * 10^k is exact if 5^k fits into the mantissa of T.
+ *
+ * @tparam T The floating-point type.
+ *
+ * @return The largest exponent k with an exact 10^k, at most 27.
+ */
+constexpr int max_exact_power()
+{
+    const int digits = std::min(std::numeric_limits<T>::digits, 63);
+
+    int exponent = 0;
+    uint64_t power = 1;
+
+    while (exponent < 27 && power * 5 < (uint64_t(1) << digits))
+    {
+        power *= 5;
+        ++exponent;
+    }
+
+    return exponent;
+}
+
+
+template <typename T>
+/**
+ * @brief Build the table of exactly representable powers of 10.
+ *
+ * @tparam T The floating-point type.
+ *
+ * @return 10^0 to 10^max_exact_power<T>().
+ */
+constexpr std::array<T, max_exact_power<T>() + 1> make_powers_of_ten()
+{
+    std::array<T, max_exact_power<T>() + 1> powers {};
+    T power = 1;
+
+    for (auto &entry : powers)
+    {
+        entry = power;
+        power *= 10;
+    }
+
+    return powers;
+}
+
+
+template <typename T>
+/// The exactly representable powers of 10 of T.
+static constexpr std::array<T, max_exact_power<T>() + 1> powers_of_ten = make_powers_of_ten<T>();
+
+
+template <typename T>
+/**
+ * @brief Return whether products and quotients of T are rounded once, to T.
+ *
+ * Excess precision (e.g. x87 double arithmetic) rounds twice and breaks the fast path.
+ *
+ * @tparam T The floating-point type.
+ *
+ * @return Whether the fast path may be used for T.
+ */
+constexpr bool rounds_exactly()
+{
+    return std::is_same_v<T, long double> || FLT_EVAL_METHOD == 0;
+}
+
+
+template <typename T>
+/**
+ * @brief Convert a plain decimal number whose value can be computed with a single rounding.
+ *
+ * Clinger's fast path: if the decimal mantissa and the power of 10 are both exact in T,
+ * one multiplication or division yields the correctly rounded value.
+ *
+ * @tparam T The floating-point type.
+ * @param text The number without sign, e.g. "6.02214076e23".
+ * @param value The converted value.
+ *
+ * @return Whether the text is a plain decimal number within the fast path's limits.
+ */
+inline bool parse_fast(const std::string_view &text, T &value)
+{
+    const char *current = text.data();
+    const char *last = text.data() + text.size();
+
+    const auto is_digit = [](const char c)
+    {
+        return static_cast<unsigned char>(c - '0') < 10;
+    };
+
+    uint64_t mantissa = 0;
+    int significant_digits = 0;
+    int exponent = 0;
+    bool any_digits = false;
+
+    // Leading zeros don't count towards the significant digits
+    while (current != last && *current == '0')
+    {
+        any_digits = true;
+        ++current;
+    }
+
+    for (; current != last && is_digit(*current); ++current)
+    {
+        mantissa = mantissa * 10 + static_cast<uint64_t>(*current - '0');
+        ++significant_digits;
+        any_digits = true;
+    }
+
+    if (current != last && *current == '.')
+    {
+        ++current;
+
+        for (; current != last && is_digit(*current); ++current)
+        {
+            if (mantissa != 0 || *current != '0')
+            {
+                mantissa = mantissa * 10 + static_cast<uint64_t>(*current - '0');
+                ++significant_digits;
+            }
+
+            --exponent;
+            any_digits = true;
+        }
+    }
+
+    if (!any_digits || significant_digits > max_mantissa_digits)
+    {
+        return false;
+    }
+
+    if (current != last && (*current == 'e' || *current == 'E'))
+    {
+        ++current;
+
+        const bool negative = (current != last && *current == '-');
+
+        if (current != last && (*current == '-' || *current == '+'))
+        {
+            ++current;
+        }
+
+        if (current == last)
+        {
+            return false;
+        }
+
+        int explicit_exponent = 0;
+
+        for (; current != last && is_digit(*current); ++current)
+        {
+            // Anything beyond is outside the fast path anyway
+            explicit_exponent = std::min(explicit_exponent * 10 + (*current - '0'), 100000);
+        }
+
+        exponent += negative ? -explicit_exponent : explicit_exponent;
+    }
+
+    if (current != last)
+    {
+        return false;
+    }
+
+    if (mantissa == 0)
+    {
+        value = T(0);
+        return true;
+    }
+
+    constexpr int max_power = max_exact_power<T>();
+    constexpr uint64_t max_mantissa = (std::numeric_limits<T>::digits >= 64)
+            ? std::numeric_limits<uint64_t>::max() : (uint64_t(1) << std::numeric_limits<T>::digits);
+
+    if (!rounds_exactly<T>() || exponent < -max_power || exponent > max_power || mantissa > max_mantissa)
+    {
+        return false;
+    }
+
+    value = static_cast<T>(mantissa);
+    value = (exponent < 0) ? value / powers_of_ten<T>[-exponent] : value * powers_of_ten<T>[exponent];
+
+    return true;
+}
+
+
+#if defined(__cpp_lib_to_chars)
+template <typename T>
+/**
+ * @brief Convert a number without sign, correctly rounded and independent of the locale.
+ *
+ * Accepts everything std::from_chars() does plus a "0x" prefix for hexadecimal floating-point numbers.
+ *
+ * @tparam T The floating-point type.
+ * @param text The number without sign.
+ * @param value The converted value.
+ *
+ * @return Whether the whole text is a number within the range of T.
+ */
+inline bool parse_slow(std::string_view text, T &value)
+{
+    std::chars_format format = std::chars_format::general;
+
+    if (text.size() > 2 && text[0] == '0' && (text[1] == 'x' || text[1] == 'X'))
+    {
+        format = std::chars_format::hex;
+        text.remove_prefix(2);
+    }
+
+    // std::from_chars() accepts a minus sign, which would be a second sign here
+    if (text.empty() || text.front() == '-')
+    {
+        return false;
+    }
+
+    const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value, format);
+    return error == std::errc() && end == text.data() + text.size();
+}
+#else
+template <typename T>
+/**
+ * @brief Convert a number without sign using std::strto*().
+ *
+ * Only used if the standard library lacks floating-point std::from_chars(),
+ * in which case the decimal point depends on the locale.
+ *
+ * @tparam T The floating-point type.
+ * @param text The number without sign.
+ * @param value The converted value.
+ *
+ * @return Whether the whole text is a number within the range of T.
+ */
+inline bool parse_slow(const std::string_view &text, T &value)
+{
+    if (text.empty() || text.front() == '-' || text.front() == '+' || std::isspace(static_cast<unsigned char>(text.front())))
+    {
+        return false;
+    }
+
+    // std::strto*() needs a null-terminated string
+    const std::string s(text);
+    char *end = nullptr;
+    errno = 0;
+
+    if constexpr (std::is_same_v<T, float>)
+    {
+        value = std::strtof(s.c_str(), &end);
+    }
+    else if constexpr (std::is_same_v<T, double>)
+    {
+        value = std::strtod(s.c_str(), &end);
+    }
+    else
+    {
+        value = std::strtold(s.c_str(), &end);
+    }
+
+
+    return errno != ERANGE && end == s.c_str() + s.size();
+}
+#endif
+
+
+} // namespace floating_point
+
+
+template <typename T>
+/**
+ * @brief Convert a string to a floating-point number of type T, correctly rounded and independent of the locale.
+ *
+ * Accepts an optional sign, decimal and scientific notation, "inf", "infinity" and "nan"
+ * as well as hexadecimal numbers like "0x1.8p3". The whole string must be a number
+ * and its value must be within the range of T.
+ *
+ * Short decimal numbers are converted with a single floating-point operation,
+ * everything else by std::from_chars().
+ *
+ * @tparam T The floating-point type.
+ * @param s The string to convert.
+ * @param value The T value of the string passed.
+ *
+ * @return Whether the conversion was successful.
+ */
+static bool parse_floating_point(const std::string_view &s, T &value)
+{
+    static_assert(std::is_floating_point_v<T>, "parse_floating_point() requires a floating-point type");
+
+    std::string_view text = s;
+    const bool negative = !text.empty() && text.front() == '-';
+
+    if (!text.empty() && (text.front() == '-' || text.front() == '+'))
+    {
+        text.remove_prefix(1);
+    }
+
+    T magnitude {};
+
+    if (!floating_point::parse_fast(text, magnitude) && !floating_point::parse_slow(text, magnitude))
+    {
+        return false;
+    }
+
+    value = negative ? -magnitude : magnitude;
+    return true;
+}
+
+
+} // namespace cppargparse
+
+#endif // CPPARGPARSE_ARGUMENTS_FLOATING_POINT_H
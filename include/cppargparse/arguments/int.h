@@ -2,9 +2,16 @@
 #define CPPARGPARSE_ARGUMENTS_INT_H
 
 #include <algorithm>
+#include <array>
 #include <cstdint>
+#include <cstring>
 #include <limits>
-#include <string>
+#include <string_view>
+#include <type_traits>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 #include <cppargparse/cmd.h>
 
@@ -13,72 +20,362 @@
 
 
 namespace cppargparse {
+namespace integer {
+
+
+/// Whether multi-byte chunks are laid out with the first character in the lowest byte.
+#if defined(_WIN32) || (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+static constexpr bool little_endian = true;
+#else
+static constexpr bool little_endian = false;
+#endif
+
+
+/// The value of an invalid digit in digit_values.
+static constexpr uint8_t invalid_digit = 0xFF;
 
 
-template <typename T>
 /**
- * @brief Custom std::stou() implementation for use without default parameters.
+ * @brief Build the lookup table of digit values.
  *
- * @tparam T The unsigned integer type to cast the result to.
- * @param s The string to convert to the typed T value.
+ * @return The lookup table: 0-9, a-z and A-Z map to 0-35, everything else to invalid_digit.
+ */
+constexpr std::array<uint8_t, 256> make_digit_values()
+{
+    std::array<uint8_t, 256> values {};
+
+    for (size_t c = 0; c < values.size(); ++c)
+    {
+        values[c] = (c >= '0' && c <= '9') ? static_cast<uint8_t>(c - '0')
+                  : (c >= 'a' && c <= 'z') ? static_cast<uint8_t>(c - 'a' + 10)
+                  : (c >= 'A' && c <= 'Z') ? static_cast<uint8_t>(c - 'A' + 10)
+                  : invalid_digit;
+    }
+
+    return values;
+}
+
+
+/// The lookup table of digit values.
+static constexpr std::array<uint8_t, 256> digit_values = make_digit_values();
+
+
+/**
+ * @brief Return the value of a digit.
+ *
+ * @param c The digit character.
+ * @param base The number base.
+ *
+ * @return The digit value or invalid_digit if the character isn't a digit in the base.
+ */
+constexpr uint8_t digit_value(const char c, const unsigned int base)
+{
+    const uint8_t value = digit_values[static_cast<unsigned char>(c)];
+    return (value < base) ? value : invalid_digit;
+}
+
+
+/**
+ * @brief Load 8 characters into an integer, first character in the lowest byte.
+ *
+ * @param chars The characters.
+ *
+ * @return The 8 characters.
+ */
+inline uint64_t load_chunk(const char *chars)
+{
+    uint64_t chunk;
+    std::memcpy(&chunk, chars, sizeof(chunk));
+
+    return chunk;
+}
+
+
+/**
+ * @brief Combine 8 digit values, one per byte with the most significant digit in the lowest byte.
+ *
+ * Combines neighbouring bytes, then 16-bit and 32-bit lanes with one multiplication each.
+ *
+ * @param chunk The digit values.
+ * @param base The number base, 10 or 16.
+ *
+ * @return The value of the 8 digits.
+ */
+constexpr uint64_t combine_chunk(uint64_t chunk, const uint64_t base)
+{
+    chunk = ((chunk * base) + (chunk >> 8)) & 0x00FF00FF00FF00FFull;
+    chunk = ((chunk * (base * base)) + (chunk >> 16)) & 0x0000FFFF0000FFFFull;
+    chunk = ((chunk * (base * base * base * base)) + (chunk >> 32)) & 0x00000000FFFFFFFFull;
+
+    return chunk;
+}
+
+
+/**
+ * @brief Convert 8 decimal digits at once.
  *
- * @return The T value of the string passed.
+ * @param chars The characters, at least 8.
+ * @param value The value of the 8 digits.
+ *
+ * @return Whether all 8 characters are decimal digits.
  */
-static T wrap_stou(const std::string &s)
+inline bool parse_decimal_chunk(const char *chars, uint64_t &value)
 {
-    unsigned long long result = std::stoull(s);
+    const uint64_t chunk = load_chunk(chars);
 
-    if (result > std::numeric_limits<unsigned int>::max())
+    // Every byte must be in [0x30, 0x39]: the high nibble is 3 before and after adding 6
+    if ((chunk & 0xF0F0F0F0F0F0F0F0ull) != 0x3030303030303030ull
+            || ((chunk + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) != 0x3030303030303030ull)
     {
-        throw std::out_of_range("stou");
+        return false;
     }
 
-    return static_cast<T>(result);
+    value = combine_chunk(chunk - 0x3030303030303030ull, 10);
+    return true;
 }
 
 
-template <typename T>
+#if defined(__SSE2__)
 /**
- * @brief std::stoi() wrapper for use without default parameters.
+ * @brief Convert 16 decimal digits at once, validating them with SSE2.
  *
- * @tparam T The signed integer type to cast the result to.
- * @param s The string to convert to the typed T value.
+ * @param chars The characters, at least 16.
+ * @param value The value of the 16 digits.
  *
- * @return The T value of the string passed.
+ * @return Whether all 16 characters are decimal digits.
  */
-static T wrap_stoi(const std::string &s)
+inline bool parse_decimal_chunk16(const char *chars, uint64_t &value)
 {
-    return static_cast<T>(std::stoi(s));
+    // Shift '0'-'9' to the 10 smallest signed bytes, so one signed comparison checks the range
+    const __m128i shifted = _mm_sub_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(chars)), _mm_set1_epi8(static_cast<char>('0' + 0x80)));
+
+    if (_mm_movemask_epi8(_mm_cmplt_epi8(shifted, _mm_set1_epi8(-128 + 10))) != 0xFFFF)
+    {
+        return false;
+    }
+
+    value = combine_chunk(load_chunk(chars) - 0x3030303030303030ull, 10) * 100000000ull
+          + combine_chunk(load_chunk(chars + 8) - 0x3030303030303030ull, 10);
+
+    return true;
 }
+#endif
 
 
-template <typename T>
 /**
- * @brief std::stoul() wrapper for use without default parameters.
+ * @brief Convert 8 hexadecimal digits at once.
  *
- * @tparam T The unsigned integer type to cast the result to.
- * @param s The string to convert to the typed T value.
+ * @param chars The characters, at least 8.
+ * @param value The value of the 8 digits.
  *
- * @return The T value of the string passed.
+ * @return Whether all 8 characters are hexadecimal digits.
  */
-static T wrap_stoul(const std::string &s)
+inline bool parse_hexadecimal_chunk(const char *chars, uint64_t &value)
 {
-    return static_cast<T>(std::stoul(s));
+    for (size_t i = 0; i < 8; ++i)
+    {
+        if (digit_value(chars[i], 16) == invalid_digit)
+        {
+            return false;
+        }
+    }
+
+    // '0'-'9' keep their low nibble, 'a'-'f' and 'A'-'F' (bit 6 set) add 9 to theirs
+    const uint64_t chunk = load_chunk(chars);
+    value = combine_chunk((chunk & 0x0F0F0F0F0F0F0F0Full) + 9 * ((chunk >> 6) & 0x0101010101010101ull), 16);
+
+    return true;
 }
 
 
+/**
+ * @brief Append digits to a magnitude, checking for overflow.
+ *
+ * @param magnitude The magnitude.
+ * @param digits The value of the appended digits.
+ * @param scale The base raised to the number of appended digits.
+ * @param limit The maximum magnitude.
+ *
+ * @return Whether the magnitude stays within the limit.
+ */
+constexpr bool append_digits(uint64_t &magnitude, const uint64_t digits, const uint64_t scale, const uint64_t limit)
+{
+    if (digits > limit || magnitude > (limit - digits) / scale)
+    {
+        return false;
+    }
+
+    magnitude = magnitude * scale + digits;
+    return true;
+}
+
+
+/// The largest magnitude a digit can be appended to without overflowing 64 bits, in any base up to 16.
+static constexpr uint64_t unchecked_magnitude = (std::numeric_limits<uint64_t>::max() - 15) / 16;
+
+
+/**
+ * @brief Convert the digits of an unsigned number.
+ *
+ * Single "_" separators are allowed between digits.
+ *
+ * @param digits The digits, without sign and base prefix.
+ * @param base The number base, 2 to 16.
+ * @param limit The maximum magnitude.
+ * @param magnitude The converted magnitude.
+ *
+ * @return Whether the digits are valid and their value doesn't exceed the limit.
+ */
+inline bool parse_magnitude(const std::string_view &digits, const unsigned int base, const uint64_t limit, uint64_t &magnitude)
+{
+    if (digits.empty() || digits.front() == '_' || digits.back() == '_')
+    {
+        return false;
+    }
+
+    const char *current = digits.data();
+    const char *last = digits.data() + digits.size();
+
+    magnitude = 0;
+
+    while (current != last)
+    {
+#if defined(__SSE2__)
+        // 16 decimal digits at a time as long as there's no separator in the way
+        if (little_endian && base == 10 && last - current >= 16)
+        {
+            uint64_t chunk = 0;
+
+            if (parse_decimal_chunk16(current, chunk))
+            {
+                if (!append_digits(magnitude, chunk, 10000000000000000ull, limit))
+                {
+                    return false;
+                }
+
+                current += 16;
+                continue;
+            }
+        }
+#endif
+
+        // 8 digits at a time as long as there's no separator in the way
+        if (little_endian && (base == 10 || base == 16) && last - current >= 8)
+        {
+            uint64_t chunk = 0;
+
+            if ((base == 10) ? parse_decimal_chunk(current, chunk) : parse_hexadecimal_chunk(current, chunk))
+            {
+                if (!append_digits(magnitude, chunk, (base == 10) ? 100000000ull : 0x100000000ull, limit))
+                {
+                    return false;
+                }
+
+                current += 8;
+                continue;
+            }
+        }
+
+        if (*current == '_')
+        {
+            if (current[-1] == '_')
+            {
+                return false;
+            }
+
+            ++current;
+            continue;
+        }
+
+        const uint8_t digit = digit_value(*current, base);
+
+        if (digit == invalid_digit)
+        {
+            return false;
+        }
+
+        // Small magnitudes can't overflow, the limit is checked at the end
+        if (magnitude <= unchecked_magnitude)
+        {
+            magnitude = magnitude * base + digit;
+        }
+        else if (!append_digits(magnitude, digit, base, limit))
+        {
+            return false;
+        }
+
+        ++current;
+    }
+
+    return magnitude <= limit;
+}
+
+
+} // namespace integer
+
+
 template <typename T>
 /**
- * @brief std::stol() wrapper for use without default parameters.
+ * @brief Convert a string to an integer of exactly type T.
  *
- * @tparam T The signed integer type to cast the result to.
- * @param s The string to convert to the typed T value.
+ * Accepts an optional sign (only "+" for unsigned types), a "0x", "0o" or "0b" base prefix
+ * and single "_" separators between digits, e.g. "-0x7fff_ffff". The whole string must be a number
+ * and its value must fit into T.
  *
- * @return The T value of the string passed.
+ * @tparam T The integer type.
+ * @param s The string to convert.
+ * @param value The T value of the string passed.
+ *
+ * @return Whether the conversion was successful.
  */
-static T wrap_stol(const std::string &s)
+static bool parse_integer(const std::string_view &s, T &value)
 {
-    return static_cast<T>(std::stol(s));
+    static_assert(std::is_integral_v<T> && sizeof(T) <= sizeof(uint64_t), "parse_integer() requires an integer type up to 64 bits");
+
+    std::string_view digits = s;
+    const bool negative = !digits.empty() && digits.front() == '-';
+
+    if (!digits.empty() && (digits.front() == '-' || digits.front() == '+'))
+    {
+        digits.remove_prefix(1);
+    }
+
+    if (negative && std::is_unsigned_v<T>)
+    {
+        return false;
+    }
+
+    unsigned int base = 10;
+
+    if (digits.size() > 2 && digits[0] == '0')
+    {
+        switch (digits[1] | 0x20)
+        {
+        case 'x': base = 16; break;
+        case 'o': base = 8; break;
+        case 'b': base = 2; break;
+        default: break;
+        }
+
+        if (base != 10)
+        {
+            digits.remove_prefix(2);
+        }
+    }
+
+    // The magnitude of the minimum of a signed type is one more than its maximum
+    const uint64_t max = static_cast<uint64_t>(std::numeric_limits<T>::max());
+    const uint64_t limit = negative ? max + 1 : max;
+
+    uint64_t magnitude = 0;
+
+    if (!integer::parse_magnitude(digits, base, limit, magnitude))
+    {
+        return false;
+    }
+
+    value = negative ? static_cast<T>(0 - magnitude) : static_cast<T>(magnitude);
+    return true;
 }
 
 
@@ -88,12 +385,19 @@ template <typename T>
  *
  * @tparam T The char type to cast the result to.
  * @param s The string to convert to the typed T value.
+ * @param value The T value of the string passed.
  *
- * @return The T value of the string passed.
+ * @return Whether the string is non-empty.
  */
-static T wrap_char(const std::string &s)
+static bool wrap_char(const std::string_view &s, T &value)
 {
-    return static_cast<T>(s.at(0));
+    if (s.empty())
+    {
+        return false;
+    }
+
+    value = static_cast<T>(s[0]);
+    return true;
 }
 
 
@@ -107,18 +411,22 @@ struct argument<type> \
 }
 
 
-/* <cstdint> type implementations. */
+/* Character type implementation, plain char takes the first character of the value. */
 
-CPPARGPARSE_INT_ARGUMENT(uint8_t, wrap_char);
-CPPARGPARSE_INT_ARGUMENT(int8_t, wrap_char);
 CPPARGPARSE_INT_ARGUMENT(char, wrap_char);
 
-CPPARGPARSE_INT_ARGUMENT(uint16_t, wrap_stou);
-CPPARGPARSE_INT_ARGUMENT(int16_t, wrap_stoi);
-CPPARGPARSE_INT_ARGUMENT(uint32_t, wrap_stou);
-CPPARGPARSE_INT_ARGUMENT(int32_t, wrap_stoi);
-CPPARGPARSE_INT_ARGUMENT(uint64_t, wrap_stoul);
-CPPARGPARSE_INT_ARGUMENT(int64_t, wrap_stol);
+/* Integer type implementations, covering every <cstdint> type from 8 to 64 bits. */
+
+CPPARGPARSE_INT_ARGUMENT(unsigned char, parse_integer);
+CPPARGPARSE_INT_ARGUMENT(signed char, parse_integer);
+CPPARGPARSE_INT_ARGUMENT(unsigned short, parse_integer);
+CPPARGPARSE_INT_ARGUMENT(short, parse_integer);
+CPPARGPARSE_INT_ARGUMENT(unsigned int, parse_integer);
+CPPARGPARSE_INT_ARGUMENT(int, parse_integer);
+CPPARGPARSE_INT_ARGUMENT(unsigned long, parse_integer);
+CPPARGPARSE_INT_ARGUMENT(long, parse_integer);
+CPPARGPARSE_INT_ARGUMENT(unsigned long long, parse_integer);
+CPPARGPARSE_INT_ARGUMENT(long long, parse_integer);
 
 
 } // namespace cppargparse
@@ -0,0 +1,150 @@
+#ifndef CPPARGPARSE_ARGUMENTS_MAP_H
+#define CPPARGPARSE_ARGUMENTS_MAP_H
+
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include <cppargparse/algorithm.h>
+#include <cppargparse/cmd.h>
+#include <cppargparse/errors.h>
+#include <cppargparse/flat_map.h>
+
+#include "argument.h"
+#include "container.h"
+
+
+namespace cppargparse {
+namespace common {
+
+
+template <typename Map>
+/**
+ * @brief Collect the "key=value" definitions of every occurrence of an option, e.g. "-D name=app -D level=3".
+ *
+ * Definitions are split on the first "=", a definition without one has an empty value.
+ * Later definitions of a key replace earlier ones.
+ *
+ * @tparam Map The map type, providing reserve() and insert_or_assign(std::string &&, mapped_type &&).
+ *
+ * @param cmd The command line.
+ * @param position The command line position of the option's first occurrence.
+ * @param cmdargs The command line arguments.
+ * @param values The map to insert the definitions into.
+ *
+ * @throws #cppargparse::errors::CommandLineOptionError if a definition is missing or its value cannot be converted.
+ */
+void parse_definitions(
+        const cmd::CommandLine_t &cmd,
+        const cmd::CommandLinePosition_t &position,
+        const cmd::CommandLineArguments_t &cmdargs,
+        Map &values)
+{
+    typedef typename Map::mapped_type T;
+
+    const auto cmdarg = algorithm::find_arg(cmdargs, *position);
+
+    // The argv scan already found every occurrence, so the map is sized once
+    const auto define = [&](const cmd::CommandLinePosition_t &occurrence)
+    {
+        const auto definition = std::next(occurrence);
+
+        if (definition == cmd.cend())
+        {
+            errors::raise<errors::CommandLineOptionError>(conversion_error<T>(cmd, definition));
+            return;
+        }
+
+        const std::string_view text = *definition;
+        const size_t separator = text.find('=');
+        const std::string_view value = (separator == std::string_view::npos) ? std::string_view() : text.substr(separator + 1);
+
+        values.insert_or_assign(std::string(text.substr(0, separator)), convert_value<T>(cmd, definition, value, cmdargs));
+    };
+
+    if (cmdarg == cmdargs.cend() || cmdarg->positions().empty())
+    {
+        values.reserve(1);
+        define(position);
+
+        return;
+    }
+
+    values.reserve(cmdarg->positions().size());
+
+    for (const auto &occurrence : cmdarg->positions())
+    {
+        define(occurrence);
+    }
+}
+
+
+} // namespace common
+
+
+template <typename T, typename Hash, typename KeyEqual, typename Allocator>
+/**
+ * @brief The argument struct for "-D key=value" style definitions collected into a std::unordered_map.
+ *
+ * @tparam T The value type. Values are converted like those of containers, see common::convert_value().
+ */
+struct argument<std::unordered_map<std::string, T, Hash, KeyEqual, Allocator>>
+{
+    /**
+     * @brief Collect the definitions of every occurrence of an option.
+     *
+     * @param cmd The command line.
+     * @param position The command line position of the option's first occurrence.
+     * @param cmdargs The command line arguments.
+     *
+     * @return The definitions.
+     * @throws #cppargparse::errors::CommandLineOptionError if a definition is missing or its value cannot be converted.
+     */
+    static const std::unordered_map<std::string, T, Hash, KeyEqual, Allocator> parse(
+            const cmd::CommandLine_t &cmd,
+            const cmd::CommandLinePosition_t &position,
+            const cmd::CommandLineArguments_t &cmdargs)
+    {
+        std::unordered_map<std::string, T, Hash, KeyEqual, Allocator> values(common::make_allocator<Allocator>(cmd));
+        common::parse_definitions(cmd, position, cmdargs, values);
+
+        return values;
+    }
+};
+
+
+template <typename T>
+/**
+ * @brief The argument struct for "-D key=value" style definitions collected into a #cppargparse::containers::FlatMap.
+ *
+ * @tparam T The value type. Values are converted like those of containers, see common::convert_value().
+ */
+struct argument<containers::FlatMap<T>>
+{
+    /**
+     * @brief Collect the definitions of every occurrence of an option.
+     *
+     * @param cmd The command line.
+     * @param position The command line position of the option's first occurrence.
+     * @param cmdargs The command line arguments.
+     *
+     * @return The definitions, in command line order.
+     * @throws #cppargparse::errors::CommandLineOptionError if a definition is missing or its value cannot be converted.
+     */
+    static const containers::FlatMap<T> parse(
+            const cmd::CommandLine_t &cmd,
+            const cmd::CommandLinePosition_t &position,
+            const cmd::CommandLineArguments_t &cmdargs)
+    {
+        containers::FlatMap<T> values;
+        common::parse_definitions(cmd, position, cmdargs, values);
+
+        return values;
+    }
+};
+
+
+} // namespace cppargparse
+
+#endif // CPPARGPARSE_ARGUMENTS_MAP_H
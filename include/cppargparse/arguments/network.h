@@ -0,0 +1,601 @@
+#ifndef CPPARGPARSE_ARGUMENTS_NETWORK_H
+#define CPPARGPARSE_ARGUMENTS_NETWORK_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include <cppargparse/cmd.h>
+
+#include "argument.h"
+#include "container.h"
+#include "numerical.h"
+
+
+namespace cppargparse {
+namespace network {
+
+
+/**
+ * @brief The family of an IP address.
+ */
+enum class Family
+{
+    V4,
+    V6
+};
+
+
+/**
+ * @brief An IPv4 or IPv6 address.
+ */
+struct IpAddress
+{
+    /// The address family.
+    Family family;
+
+    /// The address in network byte order. IPv4 addresses use the first 4 bytes, the others are 0.
+    std::array<uint8_t, 16> bytes;
+
+
+    /**
+     * @brief Return the number of bits of the address.
+     *
+     * @return 32 for IPv4 and 128 for IPv6 addresses.
+     */
+    size_t bits() const
+    {
+        return (family == Family::V4) ? 32 : 128;
+    }
+
+
+    /**
+     * @brief Compare two addresses.
+     *
+     * @param other The other address.
+     *
+     * @return Whether both addresses are of the same family and equal.
+     */
+    bool operator==(const IpAddress &other) const
+    {
+        return family == other.family && bytes == other.bytes;
+    }
+
+
+    /**
+     * @brief Compare two addresses.
+     *
+     * @param other The other address.
+     *
+     * @return Whether the addresses differ.
+     */
+    bool operator!=(const IpAddress &other) const
+    {
+        return !(*this == other);
+    }
+};
+
+
+/**
+ * @brief A network endpoint, e.g. "10.0.0.5:8080", "[::1]:53" or "example.com:443".
+ */
+struct Endpoint
+{
+    /// The host as written, without brackets. A view into the command line token, valid as long as the parser.
+    std::string_view host;
+
+    /// Whether the host is an IP address, as opposed to a host name.
+    bool numeric;
+
+    /// The IP address of numeric hosts.
+    IpAddress address;
+
+    /// The port.
+    uint16_t port;
+};
+
+
+/**
+ * @brief A CIDR block, e.g. "10.0.0.0/8" or "fd00::/8".
+ */
+struct Cidr
+{
+    /// The network address. Its host bits are 0.
+    IpAddress address;
+
+    /// The prefix length in bits.
+    uint8_t prefix;
+
+
+    /**
+     * @brief Return whether an address is inside the block.
+     *
+     * @param other The address.
+     *
+     * @return Whether the address is of the same family and its first prefix bits match.
+     */
+    bool contains(const IpAddress &other) const
+    {
+        if (other.family != address.family)
+        {
+            return false;
+        }
+
+        const size_t whole = prefix / 8;
+        const unsigned int rest = prefix % 8;
+
+        for (size_t i = 0; i < whole; ++i)
+        {
+            if (other.bytes[i] != address.bytes[i])
+            {
+                return false;
+            }
+        }
+
+        return rest == 0 || ((other.bytes[whole] ^ address.bytes[whole]) >> (8 - rest)) == 0;
+    }
+};
+
+
+/**
+ * @brief Return the value of a hexadecimal digit.
+ *
+ * @param c The character.
+ *
+ * @return The digit value or 16 if the character isn't a hexadecimal digit.
+ */
+inline unsigned int hex_digit(const char c)
+{
+    const unsigned int decimal = static_cast<unsigned char>(c - '0');
+    const unsigned int letter = static_cast<unsigned char>((c | 0x20) - 'a');
+
+    return (decimal < 10) ? decimal : (letter < 6) ? letter + 10 : 16;
+}
+
+
+/**
+ * @brief Parse a decimal number without leading zeros.
+ *
+ * @param text The text. The number is removed from its front.
+ * @param max The maximum value.
+ * @param value The number.
+ *
+ * @return Whether the text starts with a number of at most max.
+ */
+inline bool parse_decimal(std::string_view &text, const uint32_t max, uint32_t &value)
+{
+    size_t digits = 0;
+    value = 0;
+
+    for (; digits < text.size() && static_cast<unsigned char>(text[digits] - '0') < 10; ++digits)
+    {
+        value = value * 10 + static_cast<uint32_t>(text[digits] - '0');
+
+        if (value > max || (digits == 1 && text[0] == '0'))
+        {
+            return false;
+        }
+    }
+
+    text.remove_prefix(digits);
+    return digits != 0;
+}
+
+
+/**
+ * @brief Parse a dotted-quad IPv4 address into 4 bytes.
+ *
+ * @param text The text, exactly an address like "10.0.0.5". Octets have no leading zeros.
+ * @param bytes The address bytes.
+ *
+ * @return Whether the text is an IPv4 address.
+ */
+inline bool parse_ipv4(std::string_view text, uint8_t *bytes)
+{
+    for (size_t i = 0; i < 4; ++i)
+    {
+        uint32_t octet = 0;
+
+        if (i != 0)
+        {
+            if (text.empty() || text.front() != '.')
+            {
+                return false;
+            }
+
+            text.remove_prefix(1);
+        }
+
+        if (!parse_decimal(text, 255, octet))
+        {
+            return false;
+        }
+
+        bytes[i] = static_cast<uint8_t>(octet);
+    }
+
+    return text.empty();
+}
+
+
+/**
+ * @brief Parse an IPv6 address in RFC 4291 text form, e.g. "2001:db8::1" or "::ffff:10.0.0.5".
+ *
+ * @param text The text, exactly an address, without brackets or zone.
+ * @param bytes The 16 address bytes.
+ *
+ * @return Whether the text is an IPv6 address.
+ */
+inline bool parse_ipv6(std::string_view text, uint8_t *bytes)
+{
+    std::array<uint8_t, 16> parsed {};
+    size_t size = 0;
+    size_t gap = 0;
+    bool compressed = false;
+
+    if (text.substr(0, 2) == "::")
+    {
+        compressed = true;
+        text.remove_prefix(2);
+    }
+
+    while (!text.empty())
+    {
+        // A trailing IPv4 address fills the last 4 bytes
+        if (size <= 12 && text.find('.') != std::string_view::npos && text.find(':') == std::string_view::npos)
+        {
+            if (!parse_ipv4(text, parsed.data() + size))
+            {
+                return false;
+            }
+
+            size += 4;
+            break;
+        }
+
+        unsigned int group = 0;
+        size_t digits = 0;
+
+        for (; digits < text.size() && digits < 5 && hex_digit(text[digits]) < 16; ++digits)
+        {
+            group = group * 16 + hex_digit(text[digits]);
+        }
+
+        if (digits == 0 || digits > 4 || size == 16)
+        {
+            return false;
+        }
+
+        parsed[size++] = static_cast<uint8_t>(group >> 8);
+        parsed[size++] = static_cast<uint8_t>(group);
+        text.remove_prefix(digits);
+
+        if (text.empty())
+        {
+            break;
+        }
+
+        if (text.front() != ':' || text.size() == 1)
+        {
+            return false;
+        }
+
+        text.remove_prefix(1);
+
+        if (text.front() == ':')
+        {
+            if (compressed)
+            {
+                return false;
+            }
+
+            compressed = true;
+            gap = size;
+            text.remove_prefix(1);
+        }
+    }
+
+    // "::" stands for at least one zero group
+    if (compressed ? size > 14 : size != 16)
+    {
+        return false;
+    }
+
+    // Move the groups after "::" to the end, zeros fill the gap, without "::" the shift is 0
+    const size_t shift = 16 - size;
+
+    for (size_t i = 0; i < 16; ++i)
+    {
+        bytes[i] = (i < gap) ? parsed[i] : (i < gap + shift) ? 0 : parsed[i - shift];
+    }
+
+    return true;
+}
+
+
+/**
+ * @brief Return whether a text is a host name, letters, digits and '-' in dot-separated labels.
+ *
+ * @param text The text.
+ *
+ * @return Whether the text is a host name of at most 253 characters with labels of 1 to 63 characters,
+ *         none starting or ending with '-'. The last label mustn't be all digits (RFC 1123, section 2.1),
+ *         so malformed IPv4 addresses like "10.0.0.500" aren't host names.
+ */
+inline bool is_host_name(const std::string_view &text)
+{
+    if (text.empty() || text.size() > 253)
+    {
+        return false;
+    }
+
+    size_t label = 0;
+    bool digits = true;
+
+    for (size_t i = 0; i <= text.size(); ++i)
+    {
+        const char c = (i < text.size()) ? text[i] : '.';
+
+        if (c == '.')
+        {
+            if (label == 0 || label > 63 || text[i - 1] == '-')
+            {
+                return false;
+            }
+
+            label = 0;
+
+            if (i < text.size())
+            {
+                digits = true;
+            }
+        }
+        else if (hex_digit(c) < 10)
+        {
+            ++label;
+        }
+        else if (static_cast<unsigned char>((c | 0x20) - 'a') < 26 || (c == '-' && label != 0))
+        {
+            ++label;
+            digits = false;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    return !digits;
+}
+
+
+} // namespace network
+
+
+/**
+ * @brief Convert a string to an IP address, e.g. "10.0.0.5" or "2001:db8::1".
+ *
+ * @param s The string to convert.
+ * @param value The IP address.
+ *
+ * @return Whether the conversion was successful.
+ */
+static bool parse_ip_address(const std::string_view &s, network::IpAddress &value)
+{
+    value.bytes = {};
+
+    // Every IPv6 address has a ':', no IPv4 address does
+    if (s.find(':') != std::string_view::npos)
+    {
+        value.family = network::Family::V6;
+        return network::parse_ipv6(s, value.bytes.data());
+    }
+
+    value.family = network::Family::V4;
+    return network::parse_ipv4(s, value.bytes.data());
+}
+
+
+/**
+ * @brief Convert a string to an endpoint, e.g. "10.0.0.5:8080", "[::1]:53" or "example.com:443".
+ *
+ * The host refers to the string, no memory is allocated.
+ *
+ * @param s The string to convert.
+ * @param value The endpoint.
+ *
+ * @return Whether the conversion was successful.
+ */
+static bool parse_endpoint(const std::string_view &s, network::Endpoint &value)
+{
+    const size_t separator = s.rfind(':');
+
+    if (separator == std::string_view::npos)
+    {
+        return false;
+    }
+
+    std::string_view host = s.substr(0, separator);
+    std::string_view port = s.substr(separator + 1);
+    uint32_t number = 0;
+
+    if (!network::parse_decimal(port, 65535, number) || !port.empty())
+    {
+        return false;
+    }
+
+    const bool bracketed = host.size() >= 2 && host.front() == '[' && host.back() == ']';
+
+    if (bracketed)
+    {
+        host = host.substr(1, host.size() - 2);
+        value.numeric = parse_ip_address(host, value.address) && value.address.family == network::Family::V6;
+    }
+    else if (host.find(':') != std::string_view::npos)
+    {
+        // IPv6 hosts need brackets to separate them from the port
+        return false;
+    }
+    else
+    {
+        value.numeric = parse_ip_address(host, value.address);
+    }
+
+    if (!value.numeric && (bracketed || !network::is_host_name(host)))
+    {
+        return false;
+    }
+
+    value.host = host;
+    value.port = static_cast<uint16_t>(number);
+    return true;
+}
+
+
+/**
+ * @brief Convert a string to a CIDR block, e.g. "10.0.0.0/8" or "fd00::/8".
+ *
+ * @param s The string to convert.
+ * @param value The CIDR block.
+ *
+ * @return Whether the conversion was successful. Addresses with host bits set are rejected.
+ */
+static bool parse_cidr(const std::string_view &s, network::Cidr &value)
+{
+    const size_t separator = s.find('/');
+
+    if (separator == std::string_view::npos || !parse_ip_address(s.substr(0, separator), value.address))
+    {
+        return false;
+    }
+
+    std::string_view prefix = s.substr(separator + 1);
+    uint32_t bits = 0;
+
+    if (!network::parse_decimal(prefix, static_cast<uint32_t>(value.address.bits()), bits) || !prefix.empty())
+    {
+        return false;
+    }
+
+    value.prefix = static_cast<uint8_t>(bits);
+
+    // The block contains its own address only if no host bits are set
+    network::IpAddress network_address = value.address;
+
+    for (size_t bit = bits; bit < value.address.bits(); ++bit)
+    {
+        network_address.bytes[bit / 8] &= static_cast<uint8_t>(~(0x80u >> (bit % 8)));
+    }
+
+    return network_address == value.address;
+}
+
+
+template <>
+/**
+ * @brief The argument struct for IP addresses, see parse_ip_address().
+ */
+struct argument<network::IpAddress>
+{
+    CPPARGPARSE_PARSE_ARGUMENT(network::IpAddress)
+
+    CPPARGPARSE_NUMERICAL_CONVERT(network::IpAddress, parse_ip_address)
+
+
+    /**
+     * @brief Return the name of the value type for error messages.
+     *
+     * @return The type name.
+     */
+    static constexpr const char *type_name()
+    {
+        return "IP address";
+    }
+};
+
+
+template <>
+/**
+ * @brief The argument struct for endpoints, see parse_endpoint().
+ *
+ * std::vector<network::Endpoint> options are converted in bulk, see common::convert_values().
+ */
+struct argument<network::Endpoint>
+{
+    CPPARGPARSE_PARSE_ARGUMENT(network::Endpoint)
+
+    CPPARGPARSE_NUMERICAL_CONVERT(network::Endpoint, parse_endpoint)
+
+
+    /**
+     * @brief Return the name of the value type for error messages.
+     *
+     * @return The type name.
+     */
+    static constexpr const char *type_name()
+    {
+        return "endpoint";
+    }
+};
+
+
+template <>
+/**
+ * @brief The argument struct for CIDR blocks, see parse_cidr().
+ */
+struct argument<network::Cidr>
+{
+    CPPARGPARSE_PARSE_ARGUMENT(network::Cidr)
+
+    CPPARGPARSE_NUMERICAL_CONVERT(network::Cidr, parse_cidr)
+
+
+    /**
+     * @brief Return the name of the value type for error messages.
+     *
+     * @return The type name.
+     */
+    static constexpr const char *type_name()
+    {
+        return "CIDR block";
+    }
+};
+
+
+template <>
+/**
+ * @brief IP addresses are separated by ',' inside a single token, e.g. "--dns 10.0.0.1,10.0.0.2".
+ */
+struct list_delimiter<network::IpAddress>
+{
+    /// The delimiter.
+    static constexpr char value = ',';
+};
+
+
+template <>
+/**
+ * @brief Endpoints are separated by ',' inside a single token, e.g. "--backends 10.0.0.5:80,10.0.0.6:80".
+ */
+struct list_delimiter<network::Endpoint>
+{
+    /// The delimiter.
+    static constexpr char value = ',';
+};
+
+
+template <>
+/**
+ * @brief CIDR blocks are separated by ',' inside a single token, e.g. "--allow 10.0.0.0/8,192.168.0.0/16".
+ */
+struct list_delimiter<network::Cidr>
+{
+    /// The delimiter.
+    static constexpr char value = ',';
+};
+
+
+} // namespace cppargparse
+
+#endif // CPPARGPARSE_ARGUMENTS_NETWORK_H
@@ -1,9 +1,7 @@
 #ifndef CPPARGPARSE_ARGUMENTS_NUMERICAL_H
 #define CPPARGPARSE_ARGUMENTS_NUMERICAL_H
 
-#include <functional>
-#include <sstream>
-#include <string>
+#include <string_view>
 
 #include <cppargparse/cmd.h>
 #include <cppargparse/errors.h>
@@ -27,7 +25,7 @@ struct numerical_argument
      * @param cmd The command line.
      * @param position The command line argument iterator.
      * @param numerical_converter The function used to convert the cmdarg into a numerical value.
-     * @param type_string The numerical type's string representation.
+     *                            Returns whether the conversion was successful.
      *
      * @return The numerical value of the command line argument.
      * @throws #cppargparse::errors::CommandLineOptionError if the conversion was unsuccessful.
@@ -35,27 +33,18 @@ struct numerical_argument
     static T convert(
             const cmd::CommandLine_t &cmd,
             const cmd::CommandLinePosition_t &position,
-            const cmd::CommandLineArguments_t &cmdargs,
-            const std::function<T(const std::string &)> &numerical_converter)
+            const cmd::CommandLineArguments_t &,
+            bool (*numerical_converter)(const std::string_view &, T &))
     {
-        try
-        {
-            const std::string string_value = argument<std::string>::convert(cmd, position, cmdargs);
-            return numerical_converter(string_value);
-        }
+        T value {};
 
-        catch (const errors::CommandLineOptionError &error)
+        if (position == cmd.cend() || !numerical_converter(*position, value))
         {
-            throw error;
-        }
-        catch (const std::invalid_argument &)
-        {
-            throw errors::CommandLineOptionError(common::error_message<T>(std::prev(position)));
-        }
-        catch (const std::out_of_range &)
-        {
-            throw errors::CommandLineOptionError(common::error_message<T>(std::prev(position)));
+            errors::raise<errors::CommandLineOptionError>(common::conversion_error<T>(cmd, position));
+            return T();
         }
+
+        return value;
     }
 };
 
@@ -67,6 +56,11 @@ struct numerical_argument
         const cmd::CommandLineArguments_t &cmdargs) \
     { \
         return numerical_argument<type>::convert(cmd, position, cmdargs, &wrapper); \
+    } \
+\
+    static bool convert_value(const std::string_view &text, type &value) \
+    { \
+        return wrapper(text, value); \
     }
 
 
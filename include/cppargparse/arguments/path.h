@@ -0,0 +1,291 @@
+#ifndef CPPARGPARSE_ARGUMENTS_PATH_H
+#define CPPARGPARSE_ARGUMENTS_PATH_H
+
+#include <cstdint>
+#include <filesystem>
+#include <string_view>
+#include <system_error>
+
+#if !defined(_WIN32)
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <cppargparse/cmd.h>
+
+#include "argument.h"
+#include "container.h"
+#include "numerical.h"
+
+
+namespace cppargparse {
+namespace paths {
+
+
+/**
+ * @brief The checks of a path value, combined with '|', e.g. RegularFile | Readable.
+ */
+enum Check : unsigned int
+{
+    /// No check, a missing path is accepted.
+    None = 0,
+
+    /// The path exists.
+    Exists = 1,
+
+    /// The path is an existing regular file, following symbolic links.
+    RegularFile = 2 | Exists,
+
+    /// The path is an existing directory, following symbolic links.
+    Directory = 4 | Exists,
+
+    /// The path exists and the process may read it.
+    Readable = 8 | Exists
+};
+
+
+/**
+ * @brief The stat data of a path, queried once while parsing.
+ */
+struct Status
+{
+    /// The file type, std::filesystem::file_type::not_found for missing paths.
+    std::filesystem::file_type type;
+
+    /// The permission bits.
+    std::filesystem::perms permissions;
+
+    /// The size in bytes of regular files, 0 otherwise.
+    uintmax_t size;
+
+    /// Whether the process may read the path. Only queried by the Readable check, false otherwise.
+    bool readable;
+};
+
+
+/**
+ * @brief Query the stat data of a path with a single stat call.
+ *
+ * @param path The path.
+ * @param status The stat data.
+ * @param query_readable Whether to also query whether the process may read the path.
+ */
+inline void query(const std::filesystem::path &path, Status &status, const bool query_readable)
+{
+    status = Status { std::filesystem::file_type::not_found, std::filesystem::perms::unknown, 0, false };
+
+#if defined(_WIN32)
+    std::error_code error;
+    const auto file_status = std::filesystem::status(path, error);
+
+    if (error || !std::filesystem::exists(file_status))
+    {
+        return;
+    }
+
+    status.type = file_status.type();
+    status.permissions = file_status.permissions();
+    status.size = (status.type == std::filesystem::file_type::regular) ? std::filesystem::file_size(path, error) : 0;
+
+    // Windows grants reading through ACLs, the read-only attribute only prevents writing
+    status.readable = query_readable;
+#else
+    struct stat data;
+
+    if (::stat(path.c_str(), &data) != 0)
+    {
+        return;
+    }
+
+    switch (data.st_mode & S_IFMT)
+    {
+    case S_IFREG: status.type = std::filesystem::file_type::regular; break;
+    case S_IFDIR: status.type = std::filesystem::file_type::directory; break;
+    case S_IFCHR: status.type = std::filesystem::file_type::character; break;
+    case S_IFBLK: status.type = std::filesystem::file_type::block; break;
+    case S_IFIFO: status.type = std::filesystem::file_type::fifo; break;
+    case S_IFSOCK: status.type = std::filesystem::file_type::socket; break;
+    default: status.type = std::filesystem::file_type::unknown; break;
+    }
+
+    status.permissions = static_cast<std::filesystem::perms>(data.st_mode & 07777);
+    status.size = (status.type == std::filesystem::file_type::regular) ? static_cast<uintmax_t>(data.st_size) : 0;
+
+    // The permission bits alone don't tell, access() applies the process' user, groups and ACLs
+    status.readable = query_readable && ::access(path.c_str(), R_OK) == 0;
+#endif
+}
+
+
+/**
+ * @brief Return whether stat data passes a combination of checks.
+ *
+ * @param status The stat data.
+ * @param checks The checks.
+ *
+ * @return Whether the path passes all checks.
+ */
+inline bool passes(const Status &status, const unsigned int checks)
+{
+    const bool exists = (status.type != std::filesystem::file_type::not_found);
+
+    return (!(checks & Exists) || exists)
+        && ((checks & RegularFile) != RegularFile || status.type == std::filesystem::file_type::regular)
+        && ((checks & Directory) != Directory || status.type == std::filesystem::file_type::directory)
+        && ((checks & Readable) != Readable || status.readable);
+}
+
+
+template <unsigned int Checks>
+/**
+ * @brief A path validated while parsing, holding its stat data.
+ *
+ * std::vector<CheckedPath<Checks>> options stat all paths in one bulk pass, on several threads
+ * with #cppargparse::parallel::set_validation_policy(), so consumers never stat them again.
+ *
+ * @tparam Checks The checks the path must pass, see #Check.
+ */
+struct CheckedPath
+{
+    static_assert((Checks & (RegularFile | Directory)) != (RegularFile | Directory), "A path can't be both a regular file and a directory");
+
+    /// The path.
+    std::filesystem::path path;
+
+    /// The stat data of the path.
+    Status status;
+};
+
+
+template <unsigned int Checks>
+/**
+ * @brief Describe the paths passing a combination of checks, for error messages.
+ *
+ * @tparam Checks The checks.
+ *
+ * @return The description, e.g. "readable file".
+ */
+constexpr const char *describe()
+{
+    constexpr bool readable = (Checks & Readable) == Readable;
+    constexpr bool file = (Checks & RegularFile) == RegularFile;
+    constexpr bool directory = (Checks & Directory) == Directory;
+
+    if constexpr (readable)
+    {
+        return file ? "readable file" : directory ? "readable directory" : "readable path";
+    }
+    else if constexpr ((Checks & Exists) != 0)
+    {
+        return file ? "existing file" : directory ? "existing directory" : "existing path";
+    }
+    else
+    {
+        return "path";
+    }
+}
+
+
+} // namespace paths
+
+
+/**
+ * @brief Convert a string to a path.
+ *
+ * @param s The string to convert.
+ * @param value The path.
+ *
+ * @return Whether the string isn't empty.
+ */
+static bool parse_path(const std::string_view &s, std::filesystem::path &value)
+{
+    if (s.empty())
+    {
+        return false;
+    }
+
+    value = std::filesystem::path(s);
+    return true;
+}
+
+
+template <unsigned int Checks>
+/**
+ * @brief Convert a string to a checked path and stat it.
+ *
+ * @tparam Checks The checks the path must pass, see #paths::Check.
+ * @param s The string to convert.
+ * @param value The path and its stat data.
+ *
+ * @return Whether the string is a path passing the checks.
+ */
+static bool parse_checked_path(const std::string_view &s, paths::CheckedPath<Checks> &value)
+{
+    if (!parse_path(s, value.path))
+    {
+        return false;
+    }
+
+    paths::query(value.path, value.status, (Checks & paths::Readable) == paths::Readable);
+    return paths::passes(value.status, Checks);
+}
+
+
+template <>
+/**
+ * @brief The argument struct for std::filesystem::path. The path isn't checked, see paths::CheckedPath for that.
+ */
+struct argument<std::filesystem::path>
+{
+    CPPARGPARSE_PARSE_ARGUMENT(std::filesystem::path)
+
+    CPPARGPARSE_NUMERICAL_CONVERT(std::filesystem::path, parse_path)
+
+
+    /**
+     * @brief Return the name of the value type for error messages.
+     *
+     * @return The type name.
+     */
+    static constexpr const char *type_name()
+    {
+        return "path";
+    }
+};
+
+
+template <unsigned int Checks>
+/**
+ * @brief The argument struct for checked paths, e.g. "--input data.csv" as paths::CheckedPath<paths::RegularFile>.
+ *
+ * @tparam Checks The checks the path must pass, see #paths::Check.
+ */
+struct argument<paths::CheckedPath<Checks>>
+{
+    /// The checked path type.
+    typedef paths::CheckedPath<Checks> path_type;
+
+    /// Converting a value stats it, see common::validates_values.
+    static constexpr bool validates_values = true;
+
+
+    CPPARGPARSE_PARSE_ARGUMENT(path_type)
+
+    CPPARGPARSE_NUMERICAL_CONVERT(path_type, parse_checked_path<Checks>)
+
+
+    /**
+     * @brief Return the name of the value type for error messages.
+     *
+     * @return The type name, e.g. "existing file".
+     */
+    static constexpr const char *type_name()
+    {
+        return paths::describe<Checks>();
+    }
+};
+
+
+} // namespace cppargparse
+
+#endif // CPPARGPARSE_ARGUMENTS_PATH_H
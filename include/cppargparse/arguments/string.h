@@ -2,8 +2,8 @@
 #define CPPARGPARSE_ARGUMENTS_STRING_H
 
 #include <algorithm>
-#include <sstream>
 #include <string>
+#include <string_view>
 
 #include <cppargparse/cmd.h>
 #include <cppargparse/errors.h>
@@ -14,12 +14,19 @@
 namespace cppargparse {
 
 
-template <>
+template <typename Traits, typename Allocator>
 /**
- * @brief The argument struct for the std::string type.
+ * @brief The argument struct for std::string and other strings of char, e.g. std::pmr::string.
+ *
+ * @tparam Traits The character traits type.
+ * @tparam Allocator The allocator type.
  */
-struct argument<std::string>
+struct argument<std::basic_string<char, Traits, Allocator>>
 {
+    /// The string type.
+    typedef std::basic_string<char, Traits, Allocator> string_type;
+
+
     /**
      * @brief Try to parse a command line argument as a std::string.
      *
@@ -29,7 +36,7 @@ struct argument<std::string>
      *
      * @return The std::string value of the command line argument next in line.
      */
-    static const std::string parse(
+    static const string_type parse(
             const cmd::CommandLine_t &cmd,
             const cmd::CommandLinePosition_t &position,
             const cmd::CommandLineArguments_t &cmdargs)
@@ -47,33 +54,33 @@ struct argument<std::string>
      * @return The std::string value of the command line argument.
      * @throws #cppargparse::errors::CommandLineOptionError if there is no value to parse.
      */
-    static const std::string convert(
+    static const string_type convert(
             const cmd::CommandLine_t &cmd,
             const cmd::CommandLinePosition_t &position,
             const cmd::CommandLineArguments_t &)
     {
         if (position == cmd.cend())
         {
-            throw errors::CommandLineOptionError(error_message(std::prev(position)));
+            errors::raise<errors::CommandLineOptionError>(common::conversion_error<string_type>(cmd, position));
+            return string_type(common::make_allocator<Allocator>(cmd));
         }
 
-        return *position;
+        return string_type(position->data(), position->size(), common::make_allocator<Allocator>(cmd));
     }
 
 
     /**
-     * @brief Generate an error message for a value that's not a std::string.
+     * @brief Convert a value to a std::string.
      *
-     * @param position The command line argument iterator.
+     * @param text The value.
+     * @param value The string value.
      *
-     * @return An error message for a value that's not a std::string.
+     * @return true, every value is a valid string.
      */
-    static const char *error_message(const cmd::CommandLinePosition_t &position)
+    static bool convert_value(const std::string_view &text, string_type &value)
     {
-        std::ostringstream message;
-        message << "Couldn't convert " << *position << "to type <std::string>.";
-
-        return message.str().c_str();
+        value.assign(text.data(), text.size());
+        return true;
     }
 };
 
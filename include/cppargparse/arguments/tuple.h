@@ -0,0 +1,155 @@
+#ifndef CPPARGPARSE_ARGUMENTS_TUPLE_H
+#define CPPARGPARSE_ARGUMENTS_TUPLE_H
+
+#include <tuple>
+#include <utility>
+
+#include <cppargparse/cmd.h>
+
+#include "argument.h"
+
+
+namespace cppargparse {
+namespace common {
+
+
+template <typename T>
+/**
+ * @brief Convert the value at a command line position and advance the position to the next value.
+ *
+ * @tparam T The value type.
+ *
+ * @param cmd The command line.
+ * @param position The command line position of the value, advanced unless it is cmd.cend().
+ * @param cmdargs The command line arguments.
+ *
+ * @return The converted value.
+ * @throws #cppargparse::errors::CommandLineOptionError if the value is missing or cannot be converted.
+ */
+T convert_next(const cmd::CommandLine_t &cmd, cmd::CommandLinePosition_t &position, const cmd::CommandLineArguments_t &cmdargs)
+{
+    const auto current = position;
+
+    if (position != cmd.cend())
+    {
+        ++position;
+    }
+
+    return argument<T>::convert(cmd, current, cmdargs);
+}
+
+
+} // namespace common
+
+
+template <typename First, typename Second>
+/**
+ * @brief The argument struct for pairs, e.g. "--range 10 20" for std::pair<int, int>.
+ *
+ * Consumes exactly two tokens and converts each with its own type's argument::convert().
+ *
+ * @tparam First The type of the first value.
+ * @tparam Second The type of the second value.
+ */
+struct argument<std::pair<First, Second>>
+{
+    /**
+     * @brief Parse the two values of an option into a pair.
+     *
+     * @param cmd The command line.
+     * @param position The command line position of the option.
+     * @param cmdargs The command line arguments.
+     *
+     * @return The pair of converted values.
+     * @throws #cppargparse::errors::CommandLineOptionError if a value is missing or cannot be converted.
+     */
+    static const std::pair<First, Second> parse(
+            const cmd::CommandLine_t &cmd,
+            const cmd::CommandLinePosition_t &position,
+            const cmd::CommandLineArguments_t &cmdargs)
+    {
+        return convert(cmd, std::next(position), cmdargs);
+    }
+
+
+    /**
+     * @brief Convert the next two values into a pair.
+     *
+     * @param cmd The command line.
+     * @param position The command line position of the first value.
+     * @param cmdargs The command line arguments.
+     *
+     * @return The pair of converted values.
+     * @throws #cppargparse::errors::CommandLineOptionError if a value is missing or cannot be converted.
+     */
+    static const std::pair<First, Second> convert(
+            const cmd::CommandLine_t &cmd,
+            const cmd::CommandLinePosition_t &position,
+            const cmd::CommandLineArguments_t &cmdargs)
+    {
+        auto current = position;
+
+        // Braced initialization converts the values from left to right
+        return std::pair<First, Second> {
+            common::convert_next<First>(cmd, current, cmdargs),
+            common::convert_next<Second>(cmd, current, cmdargs)
+        };
+    }
+};
+
+
+template <typename... Types>
+/**
+ * @brief The argument struct for tuples, e.g. "--point 1.5 2.5 label" for std::tuple<float, float, std::string>.
+ *
+ * Consumes exactly one token per value and converts each with its own type's argument::convert().
+ *
+ * @tparam Types The value types.
+ */
+struct argument<std::tuple<Types...>>
+{
+    /**
+     * @brief Parse the values of an option into a tuple.
+     *
+     * @param cmd The command line.
+     * @param position The command line position of the option.
+     * @param cmdargs The command line arguments.
+     *
+     * @return The tuple of converted values.
+     * @throws #cppargparse::errors::CommandLineOptionError if a value is missing or cannot be converted.
+     */
+    static const std::tuple<Types...> parse(
+            const cmd::CommandLine_t &cmd,
+            const cmd::CommandLinePosition_t &position,
+            const cmd::CommandLineArguments_t &cmdargs)
+    {
+        return convert(cmd, std::next(position), cmdargs);
+    }
+
+
+    /**
+     * @brief Convert the next sizeof...(Types) values into a tuple.
+     *
+     * @param cmd The command line.
+     * @param position The command line position of the first value.
+     * @param cmdargs The command line arguments.
+     *
+     * @return The tuple of converted values.
+     * @throws #cppargparse::errors::CommandLineOptionError if a value is missing or cannot be converted.
+     */
+    static const std::tuple<Types...> convert(
+            const cmd::CommandLine_t &cmd,
+            const cmd::CommandLinePosition_t &position,
+            const cmd::CommandLineArguments_t &cmdargs)
+    {
+        auto current = position;
+
+        // Braced initialization converts the values from left to right
+        return std::tuple<Types...> { common::convert_next<Types>(cmd, current, cmdargs)... };
+    }
+};
+
+
+} // namespace cppargparse
+
+#endif // CPPARGPARSE_ARGUMENTS_TUPLE_H
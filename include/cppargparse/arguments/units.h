@@ -0,0 +1,427 @@
+#ifndef CPPARGPARSE_ARGUMENTS_UNITS_H
+#define CPPARGPARSE_ARGUMENTS_UNITS_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <ratio>
+#include <string_view>
+#include <type_traits>
+
+
+namespace cppargparse {
+namespace units {
+
+
+/**
+ * @brief A number of bytes, e.g. "4GiB".
+ */
+struct ByteSize
+{
+    /// The number of bytes.
+    uint64_t bytes;
+};
+
+
+/**
+ * @brief A unit as a fraction of its base unit, e.g. 1/1000 for milliseconds in seconds.
+ */
+struct Unit
+{
+    /// The numerator.
+    uint64_t num;
+
+    /// The denominator.
+    uint64_t den;
+};
+
+
+/**
+ * @brief Pack a unit suffix of at most 7 characters into an integer, e.g. for switch statements.
+ *
+ * @param suffix The unit suffix.
+ *
+ * @return The length in the top byte and the characters in the low bytes, 0 for empty or longer suffixes.
+ */
+constexpr uint64_t pack(const std::string_view &suffix)
+{
+    if (suffix.size() > 7)
+    {
+        return 0;
+    }
+
+    uint64_t packed = static_cast<uint64_t>(suffix.size()) << 56;
+
+    for (size_t i = 0; i < suffix.size(); ++i)
+    {
+        packed |= static_cast<uint64_t>(static_cast<unsigned char>(suffix[i])) << (8 * i);
+    }
+
+    return packed;
+}
+
+
+/**
+ * @brief Split a magnitude like "1.5" off the front of a value like "1.5GiB".
+ *
+ * The magnitude is returned as the exact fraction mantissa / scale, with scale a power of ten.
+ * Trailing zeros of the fractional part are ignored.
+ *
+ * @param text The value. The magnitude is removed, leaving the unit suffix.
+ * @param mantissa The digits of the magnitude without the decimal point.
+ * @param scale 10 to the power of the number of fractional digits.
+ *
+ * @return Whether there is a magnitude with at least one digit whose mantissa fits into 64 bits.
+ */
+inline bool parse_magnitude(std::string_view &text, uint64_t &mantissa, uint64_t &scale)
+{
+    const auto is_digit = [](const char c)
+    {
+        return static_cast<unsigned char>(c - '0') < 10;
+    };
+
+    size_t integral_end = 0;
+
+    while (integral_end < text.size() && is_digit(text[integral_end]))
+    {
+        ++integral_end;
+    }
+
+    size_t end = integral_end;
+    size_t fraction_end = integral_end;
+
+    if (end < text.size() && text[end] == '.')
+    {
+        ++end;
+
+        while (end < text.size() && is_digit(text[end]))
+        {
+            ++end;
+        }
+
+        fraction_end = end;
+
+        while (fraction_end > integral_end + 1 && text[fraction_end - 1] == '0')
+        {
+            --fraction_end;
+        }
+    }
+
+    if (end == 0 || (end == 1 && integral_end == 0))
+    {
+        return false;
+    }
+
+    mantissa = 0;
+    scale = 1;
+
+    for (size_t i = 0; i < fraction_end; ++i)
+    {
+        if (i == integral_end)
+        {
+            continue;
+        }
+
+        if (__builtin_mul_overflow(mantissa, 10, &mantissa) || __builtin_add_overflow(mantissa, static_cast<uint64_t>(text[i] - '0'), &mantissa))
+        {
+            return false;
+        }
+
+        if (i > integral_end)
+        {
+            // More fractional digits than 10^19 can scale are more precise than any unit
+            if (scale > std::numeric_limits<uint64_t>::max() / 10)
+            {
+                return false;
+            }
+
+            scale *= 10;
+        }
+    }
+
+    text.remove_prefix(end);
+    return true;
+}
+
+
+/**
+ * @brief Compute mantissa / scale * unit.num / unit.den * ratio_num / ratio_den exactly.
+ *
+ * Every numerator factor is reduced against every denominator factor first,
+ * so the product only overflows if the exact result does.
+ *
+ * @param mantissa The magnitude mantissa, see parse_magnitude().
+ * @param scale The magnitude scale, see parse_magnitude().
+ * @param unit The unit of the magnitude.
+ * @param ratio_num The numerator of the target unit's reciprocal.
+ * @param ratio_den The denominator of the target unit's reciprocal.
+ * @param value The result.
+ *
+ * @return Whether the result is an integer that fits into 64 bits.
+ */
+inline bool scale_exactly(const uint64_t mantissa, const uint64_t scale, const Unit &unit,
+                          const uint64_t ratio_num, const uint64_t ratio_den, uint64_t &value)
+{
+    std::array<uint64_t, 3> num { mantissa, unit.num, ratio_num };
+    std::array<uint64_t, 3> den { scale, unit.den, ratio_den };
+
+    if (mantissa == 0)
+    {
+        value = 0;
+        return true;
+    }
+
+    for (auto &n : num)
+    {
+        for (auto &d : den)
+        {
+            const uint64_t divisor = std::gcd(n, d);
+            n /= divisor;
+            d /= divisor;
+        }
+    }
+
+    if (den[0] != 1 || den[1] != 1 || den[2] != 1)
+    {
+        return false;
+    }
+
+    return !__builtin_mul_overflow(num[0], num[1], &value) && !__builtin_mul_overflow(value, num[2], &value);
+}
+
+
+template <typename T>
+/**
+ * @brief Store a magnitude with sign in an integer or floating-point type.
+ *
+ * @tparam T The value type.
+ * @param negative Whether the value is negative.
+ * @param magnitude The magnitude.
+ * @param value The value.
+ *
+ * @return Whether the value is within the range of T.
+ */
+bool store(const bool negative, const uint64_t magnitude, T &value)
+{
+    if constexpr (std::is_floating_point_v<T>)
+    {
+        value = negative ? -static_cast<T>(magnitude) : static_cast<T>(magnitude);
+        return true;
+    }
+    else if constexpr (std::is_signed_v<T>)
+    {
+        const uint64_t limit = static_cast<uint64_t>(std::numeric_limits<T>::max()) + (negative ? 1 : 0);
+
+        if (magnitude > limit)
+        {
+            return false;
+        }
+
+        // Negating in the unsigned domain keeps the minimum value well-defined
+        value = static_cast<T>(negative ? static_cast<std::make_signed_t<uint64_t>>(0 - magnitude) : static_cast<std::make_signed_t<uint64_t>>(magnitude));
+        return true;
+    }
+    else
+    {
+        if ((negative && magnitude != 0) || magnitude > static_cast<uint64_t>(std::numeric_limits<T>::max()))
+        {
+            return false;
+        }
+
+        value = static_cast<T>(magnitude);
+        return true;
+    }
+}
+
+
+/**
+ * @brief Look up a time unit suffix.
+ *
+ * @param suffix The suffix: "ns", "us" (or "µs"), "ms", "s", "m" (or "min"), "h" or "d".
+ * @param unit The unit in seconds.
+ *
+ * @return Whether the suffix is a time unit.
+ */
+inline bool time_unit(const std::string_view &suffix, Unit &unit)
+{
+    switch (pack(suffix))
+    {
+    case pack("ns"):
+        unit = Unit { 1, 1000000000 };
+        return true;
+
+    case pack("us"):
+    case pack("\xC2\xB5s"):
+        unit = Unit { 1, 1000000 };
+        return true;
+
+    case pack("ms"):
+        unit = Unit { 1, 1000 };
+        return true;
+
+    case pack("s"):
+        unit = Unit { 1, 1 };
+        return true;
+
+    case pack("m"):
+    case pack("min"):
+        unit = Unit { 60, 1 };
+        return true;
+
+    case pack("h"):
+        unit = Unit { 3600, 1 };
+        return true;
+
+    case pack("d"):
+        unit = Unit { 86400, 1 };
+        return true;
+
+    default:
+        return false;
+    }
+}
+
+
+/**
+ * @brief Look up a byte size unit suffix.
+ *
+ * @param suffix The suffix: "" or "B", an SI prefix "k" (or "K"), "M", "G", "T", "P", "E"
+ *               or an IEC prefix "Ki", "Mi", "Gi", "Ti", "Pi", "Ei", each optionally followed by "B".
+ * @param unit The unit in bytes.
+ *
+ * @return Whether the suffix is a byte size unit.
+ */
+inline bool byte_unit(std::string_view suffix, Unit &unit)
+{
+    if (!suffix.empty() && suffix.back() == 'B')
+    {
+        suffix.remove_suffix(1);
+    }
+
+    const bool binary = (suffix.size() == 2 && suffix[1] == 'i');
+
+    if (suffix.size() > (binary ? 2u : 1u))
+    {
+        return false;
+    }
+
+    int exponent = 0;
+
+    switch (suffix.empty() ? '\0' : suffix[0])
+    {
+    case '\0': exponent = 0; break;
+    case 'k':
+    case 'K': exponent = 1; break;
+    case 'M': exponent = 2; break;
+    case 'G': exponent = 3; break;
+    case 'T': exponent = 4; break;
+    case 'P': exponent = 5; break;
+    case 'E': exponent = 6; break;
+    default: return false;
+    }
+
+    // SI prefixes are powers of 1000, IEC prefixes powers of 1024
+    unit = Unit { binary ? (uint64_t(1) << (10 * exponent)) : 1, 1 };
+
+    for (int i = 0; i < exponent && !binary; ++i)
+    {
+        unit.num *= 1000;
+    }
+
+    return true;
+}
+
+
+} // namespace units
+
+
+template <typename Duration>
+/**
+ * @brief Convert a string to a std::chrono::duration, e.g. "250ms", "1.5h" or "-2s".
+ *
+ * A magnitude without a unit counts periods of the duration itself.
+ * Values that aren't a whole number of periods or don't fit into the duration are rejected.
+ *
+ * @tparam Duration The std::chrono::duration type.
+ * @param s The string to convert.
+ * @param value The duration.
+ *
+ * @return Whether the conversion was successful.
+ */
+static bool parse_duration(const std::string_view &s, Duration &value)
+{
+    typedef typename Duration::rep Rep;
+    typedef typename Duration::period Period;
+
+    std::string_view text = s;
+    const bool negative = !text.empty() && text.front() == '-';
+
+    if (!text.empty() && (text.front() == '-' || text.front() == '+'))
+    {
+        text.remove_prefix(1);
+    }
+
+    uint64_t mantissa = 0;
+    uint64_t scale = 1;
+    units::Unit unit { static_cast<uint64_t>(Period::num), static_cast<uint64_t>(Period::den) };
+
+    if (!units::parse_magnitude(text, mantissa, scale) || (!text.empty() && !units::time_unit(text, unit)))
+    {
+        return false;
+    }
+
+    Rep count {};
+
+    if constexpr (std::is_floating_point_v<Rep>)
+    {
+        count = static_cast<Rep>(static_cast<long double>(mantissa) / scale * unit.num / unit.den * Period::den / Period::num);
+        count = negative ? -count : count;
+    }
+    else
+    {
+        uint64_t magnitude = 0;
+
+        if (!units::scale_exactly(mantissa, scale, unit, static_cast<uint64_t>(Period::den), static_cast<uint64_t>(Period::num), magnitude)
+                || !units::store(negative, magnitude, count))
+        {
+            return false;
+        }
+    }
+
+    value = Duration(count);
+    return true;
+}
+
+
+/**
+ * @brief Convert a string to a byte size, e.g. "512", "64kB", "1.5GiB".
+ *
+ * Values that aren't a whole number of bytes or don't fit into 64 bits are rejected.
+ *
+ * @param s The string to convert.
+ * @param value The byte size.
+ *
+ * @return Whether the conversion was successful.
+ */
+static bool parse_byte_size(const std::string_view &s, units::ByteSize &value)
+{
+    std::string_view text = s;
+
+    uint64_t mantissa = 0;
+    uint64_t scale = 1;
+    units::Unit unit { 1, 1 };
+
+    if (!units::parse_magnitude(text, mantissa, scale) || !units::byte_unit(text, unit))
+    {
+        return false;
+    }
+
+    return units::scale_exactly(mantissa, scale, unit, 1, 1, value.bytes);
+}
+
+
+} // namespace cppargparse
+
+#endif // CPPARGPARSE_ARGUMENTS_UNITS_H
@@ -7,20 +7,36 @@
  */
 
 
+#include <cstddef>
+#include <limits>
+#include <memory_resource>
 #include <string>
+#include <string_view>
 #include <vector>
 
 
 namespace cppargparse {
+
+namespace parser {
+class ArgumentParser;
+
+template <size_t MaxOptions, size_t MaxTokens>
+class StaticArgumentParser;
+} // namespace parser
+
 namespace cmd {
 
 
 /**
  * @brief The command line type.
  *
+ * Holds views of the normalised command line tokens, see #cppargparse::lexer::Lexer.
+ * The viewed characters are owned by whoever lexed the command line, e.g. the argument parser.
+ * Its memory resource is also used for the values of std::pmr containers converted from it.
+ *
  * Example: "-t 5 -o output.txt"
  */
-typedef std::vector<std::string> CommandLine_t;
+typedef std::pmr::vector<std::string_view> CommandLine_t;
 
 
 /**
@@ -32,15 +48,39 @@ typedef CommandLine_t::const_iterator CommandLinePosition_t;
 /**
  * @brief The command line iterator positions type.
  */
-typedef std::vector<CommandLinePosition_t> CommandLinePositions_t;
+typedef std::pmr::vector<CommandLinePosition_t> CommandLinePositions_t;
+
+
+/**
+ * @brief Return whether a command line token is one of an argument's IDs.
+ *
+ * Empty tokens, e.g. from an argv entry "", never match, so an unset alternative ID doesn't match them either.
+ *
+ * @param token The command line token.
+ * @param id The argument ID.
+ * @param id_alt The argument alternative ID, empty if there is none.
+ *
+ * @return Whether the token is non-empty and equal to one of the IDs.
+ */
+constexpr bool is_arg_id(const std::string_view &token, const std::string_view &id, const std::string_view &id_alt)
+{
+    return !token.empty() && (token == id || token == id_alt);
+}
 
 
 /**
  * @brief The command line argument class.
+ *
+ * Allocator-aware: the argument positions are stored using the memory resource passed on construction,
+ * which a std::pmr container of arguments passes automatically.
+ * The argument ID, alternative ID and description are definitions and use the default allocator.
  */
 class CommandLineArgument
 {
 public:
+    /// The allocator type used for the argument positions.
+    typedef CommandLinePositions_t::allocator_type allocator_type;
+
     CommandLineArgument() = delete;
     CommandLineArgument& operator= (const CommandLineArgument& command_line_argument);
 
@@ -49,12 +89,33 @@ public:
      *
      * @param id The argument ID.
      * @param position The argument command line argument iterator position.
+     * @param allocator The allocator used for the argument positions.
+     */
+    CommandLineArgument(
+            const std::string &id,
+            const CommandLinePosition_t &position,
+            const allocator_type &allocator = allocator_type()
+    )
+        : CommandLineArgument(id, "", "", position, allocator)
+    {
+    }
+
+
+    /**
+     * @brief c'tor
+     *
+     * @param id The argument ID.
+     * @param id_alt The alternative argument ID.
+     * @param position The argument command line argument iterator position.
+     * @param allocator The allocator used for the argument positions.
      */
     CommandLineArgument(
             const std::string &id,
-            const CommandLinePosition_t &position
+            const std::string &id_alt,
+            const CommandLinePosition_t &position,
+            const allocator_type &allocator = allocator_type()
     )
-        : CommandLineArgument(id, "", "", position)
+        : CommandLineArgument(id, id_alt, "", position, allocator)
     {
     }
 
@@ -64,14 +125,18 @@ public:
      *
      * @param id The argument ID.
      * @param id_alt The alternative argument ID.
+     * @param description The argument description.
      * @param position The argument command line argument iterator position.
+     * @param allocator The allocator used for the argument positions.
      */
     CommandLineArgument(
             const std::string &id,
             const std::string &id_alt,
-            const CommandLinePosition_t &position
+            const std::string &description,
+            const CommandLinePosition_t &position,
+            const allocator_type &allocator = allocator_type()
     )
-        : CommandLineArgument(id, id_alt, "", position)
+        : CommandLineArgument(id, id_alt, description, position, CommandLinePositions_t(allocator), allocator)
     {
     }
 
@@ -83,17 +148,57 @@ public:
      * @param id_alt The alternative argument ID.
      * @param description The argument description.
      * @param position The argument command line argument iterator position.
+     * @param positions The command line iterator positions of every occurrence of the argument.
+     * @param allocator The allocator used for the argument positions.
      */
     CommandLineArgument(
             const std::string &id,
             const std::string &id_alt,
             const std::string &description,
-            const CommandLinePosition_t &position
+            const CommandLinePosition_t &position,
+            const CommandLinePositions_t &positions,
+            const allocator_type &allocator = allocator_type()
     )
         : m_id(id)
         , m_id_alt(id_alt)
         , m_description(description)
         , m_position(position)
+        , m_positions(positions, allocator)
+        , m_index(std::numeric_limits<size_t>::max())
+        , m_negatable(false)
+    {
+    }
+
+
+    /**
+     * @brief copy c'tor
+     *
+     * Like std::pmr containers, the copy uses the default memory resource, so argument handles returned
+     * by the parser may outlive the parser's memory resource. Copies into std::pmr containers use
+     * the allocator-extended copy c'tor instead.
+     *
+     * @param other The command line argument to copy.
+     */
+    CommandLineArgument(const CommandLineArgument &other)
+        : CommandLineArgument(other, allocator_type())
+    {
+    }
+
+
+    /**
+     * @brief Allocator-extended copy c'tor
+     *
+     * @param other The command line argument to copy.
+     * @param allocator The allocator used for the argument positions.
+     */
+    CommandLineArgument(const CommandLineArgument &other, const allocator_type &allocator)
+        : m_id(other.m_id)
+        , m_id_alt(other.m_id_alt)
+        , m_description(other.m_description)
+        , m_position(other.m_position)
+        , m_positions(other.m_positions, allocator)
+        , m_index(other.m_index)
+        , m_negatable(other.m_negatable)
     {
     }
 
@@ -142,7 +247,46 @@ public:
     }
 
 
+    /**
+     * @brief Return the positions of every occurrence of the argument.
+     *
+     * @return The argument positions, in command line order.
+     */
+    const CommandLinePositions_t &positions() const
+    {
+        return m_positions;
+    }
+
+
+    /**
+     * @brief Return the index of the argument inside the argument parser it was registered with.
+     *
+     * @return The registration index or std::numeric_limits<size_t>::max() if the argument hasn't been registered.
+     */
+    size_t index() const
+    {
+        return m_index;
+    }
+
+
+    /**
+     * @brief Return whether the argument is a boolean argument whose long IDs can be negated, e.g. "--no-cache".
+     *
+     * @return Whether the argument has been registered with add_bool().
+     */
+    bool negatable() const
+    {
+        return m_negatable;
+    }
+
+
 private:
+    /// The argument parsers resolve positions and assign registration indices.
+    friend class parser::ArgumentParser;
+
+    template <size_t MaxOptions, size_t MaxTokens>
+    friend class parser::StaticArgumentParser;
+
     /// The argument ID.
     /// Example: "-t"
     const std::string m_id;
@@ -157,14 +301,24 @@ private:
 
     /// The argument command line argument iterator position.
     /// Example: cmd_position for ("-t", "--timeout") is the argument iterator position 0.
-    const CommandLinePosition_t m_position;
+    CommandLinePosition_t m_position;
+
+    /// The command line iterator positions of every occurrence of the argument.
+    /// Example: positions for "-I" in "-I a -I b" are the argument iterator positions 0 and 2.
+    CommandLinePositions_t m_positions;
+
+    /// The index of the argument inside the argument parser it was registered with.
+    size_t m_index;
+
+    /// Whether "--no-<name>" occurrences count as occurrences of the argument and the last occurrence is its position.
+    bool m_negatable;
 };
 
 
 /**
  * @brief The command line arguments type.
  */
-typedef std::vector<CommandLineArgument> CommandLineArguments_t;
+typedef std::pmr::vector<CommandLineArgument> CommandLineArguments_t;
 
 
 /**
@@ -9,7 +9,16 @@
 
 #include <cppargparse/cmd.h>
 #include <cppargparse/arguments.h>
+#include <cppargparse/flat_map.h>
+#include <cppargparse/layout.h>
+#include <cppargparse/lexer.h>
+#include <cppargparse/parallel.h>
 #include <cppargparse/parser.h>
+#include <cppargparse/split.h>
+#include <cppargparse/static_parser.h>
+#include <cppargparse/terminal.h>
+#include <cppargparse/tokenizer.h>
+#include <cppargparse/utf8.h>
 #include <cppargparse/errors.h>
 
 #endif // CPPARGPARSE_H
@@ -1,15 +1,197 @@
 #ifndef CPPARGPARSE_ERRORS_H
 #define CPPARGPARSE_ERRORS_H
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <limits>
+#include <memory_resource>
 #include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+/**
+ * Define CPPARGPARSE_NO_EXCEPTIONS to use the library without exceptions, e.g. with -fno-exceptions.
+ * Failures are then recorded as #cppargparse::errors::last_error() and passed to the handler
+ * installed with #cppargparse::errors::set_error_handler() instead of being thrown.
+ */
+#if !defined(CPPARGPARSE_NO_EXCEPTIONS) && !defined(__cpp_exceptions)
+#define CPPARGPARSE_NO_EXCEPTIONS
+#endif
 
 
 namespace cppargparse {
 namespace errors {
 
 
+/**
+ * @brief Error codes reported by the exception-free interfaces.
+ */
+enum class ErrorCode
+{
+    /// No error occurred.
+    None,
+
+    /// A fixed-capacity storage limit has been exceeded.
+    CapacityExceeded,
+
+    /// The argument hasn't been passed to the command line.
+    ArgumentNotFound,
+
+    /// The argument value is missing or cannot be converted.
+    InvalidValue,
+
+    /// The command string is malformed, e.g. a quote is not closed.
+    SyntaxError
+};
+
+
+/**
+ * @brief A problem found by #cppargparse::parser::ArgumentParser::validate().
+ *
+ * The message is formatted on request only, see #cppargparse::parser::ArgumentParser::describe().
+ */
+struct Diagnostic
+{
+    /// What went wrong.
+    ErrorCode code;
+
+    /// The index of the offending command line token, the command line size if the argument is missing.
+    size_t token;
+
+    /// The registration index of the argument, see #cppargparse::cmd::CommandLineArgument::index().
+    size_t argument;
+
+    /// Whether the argument is a positional argument.
+    bool positional;
+
+    /// The name of the expected value type, a static string.
+    const char *expected_type;
+};
+
+
+/// The diagnostics, in argument declaration order.
+typedef std::pmr::vector<Diagnostic> Diagnostics_t;
+
+
+/// The token or argument index of an error that doesn't refer to one.
+static constexpr size_t no_index = std::numeric_limits<size_t>::max();
+
+
+/**
+ * @brief The structured payload of an error. Trivially copyable, so building it never allocates.
+ */
+struct ErrorPayload
+{
+    /// What went wrong.
+    ErrorCode code;
+
+    /// The index of the offending command line token or #no_index.
+    size_t token;
+
+    /// The registration index of the argument or #no_index.
+    size_t argument;
+
+    /// The name of the expected value type, a static string or nullptr.
+    const char *expected_type;
+
+    /// The null-terminated offending token or argument ID, truncated with "..." if it's too long.
+    char subject[32];
+};
+
+
+/**
+ * @brief Build an error payload.
+ *
+ * @param code What went wrong.
+ * @param token The index of the offending command line token or #no_index.
+ * @param argument The registration index of the argument or #no_index.
+ * @param expected_type The name of the expected value type, a static string or nullptr.
+ * @param subject The offending token or argument ID, copied into the payload.
+ *
+ * @return The error payload.
+ */
+inline ErrorPayload make_payload(ErrorCode code, size_t token, size_t argument, const char *expected_type, const std::string_view &subject)
+{
+    static constexpr std::string_view ellipsis = "...";
+
+    ErrorPayload payload { code, token, argument, expected_type, {} };
+    const size_t capacity = sizeof(payload.subject) - 1;
+
+    if (subject.size() <= capacity)
+    {
+        std::memcpy(payload.subject, subject.data(), subject.size());
+    }
+    else
+    {
+        std::memcpy(payload.subject, subject.data(), capacity - ellipsis.size());
+        std::memcpy(payload.subject + capacity - ellipsis.size(), ellipsis.data(), ellipsis.size());
+    }
+
+    return payload;
+}
+
+
+/**
+ * @brief Render the message of an error payload.
+ *
+ * @param payload The error payload.
+ * @param buffer The buffer to write the null-terminated message to.
+ * @param size The buffer size, at least 1. Longer messages are truncated.
+ *
+ * @return The message length.
+ */
+inline size_t render(const ErrorPayload &payload, char *buffer, size_t size)
+{
+    int length = 0;
+
+    switch (payload.code)
+    {
+    case ErrorCode::ArgumentNotFound:
+        length = (payload.subject[0] != '\0')
+                ? std::snprintf(buffer, size, "Cannot find argument: %s", payload.subject)
+                : std::snprintf(buffer, size, "Cannot find positional argument #%zu", payload.argument + 1);
+        break;
+
+    case ErrorCode::InvalidValue:
+        length = (payload.subject[0] != '\0')
+                ? std::snprintf(buffer, size, "Couldn't convert \"%s\" to type <%s> (token %zu)",
+                                payload.subject, payload.expected_type ? payload.expected_type : "?", payload.token)
+                : std::snprintf(buffer, size, "Missing value of type <%s> (token %zu)",
+                                payload.expected_type ? payload.expected_type : "?", payload.token);
+        break;
+
+    case ErrorCode::CapacityExceeded:
+        length = std::snprintf(buffer, size, "Capacity exceeded");
+        break;
+
+    case ErrorCode::SyntaxError:
+        length = (payload.subject[0] != '\0')
+                ? std::snprintf(buffer, size, "Unterminated quote: %s", payload.subject)
+                : std::snprintf(buffer, size, "Syntax error");
+        break;
+
+    case ErrorCode::None:
+        length = std::snprintf(buffer, size, "No error");
+        break;
+    }
+
+    return (length < 0) ? 0 : std::min(static_cast<size_t>(length), size - 1);
+}
+
+
 /**
  * @brief Base error class.
+ *
+ * Carries either a structured payload or a custom message. A payload is rendered into a fixed buffer
+ * on construction and the std::runtime_error base is built from an empty string, so throwing and
+ * catching an error with a payload doesn't allocate. what() only reads, so copies shared between
+ * threads, e.g. through std::exception_ptr, are safe.
  */
 class Error : public std::runtime_error
 {
@@ -18,11 +200,72 @@ public:
      * @brief c'tor
      *
      * @param message The error message.
+     * @param code The error code.
      */
-    explicit Error(const std::string &message)
+    explicit Error(const std::string &message, ErrorCode code = ErrorCode::None)
         : std::runtime_error(std::string("Error: ") + message)
+        , m_payload(make_payload(code, no_index, no_index, nullptr, std::string_view()))
+        , m_what()
+    {
+    }
+
+
+    /**
+     * @brief c'tor
+     *
+     * @param payload The error payload.
+     */
+    explicit Error(const ErrorPayload &payload)
+        : std::runtime_error("")
+        , m_payload(payload)
+        , m_what()
     {
+        static constexpr std::string_view prefix = "Error: ";
+
+        std::memcpy(m_what.data(), prefix.data(), prefix.size());
+        render(m_payload, m_what.data() + prefix.size(), m_what.size() - prefix.size());
     }
+
+
+    /**
+     * @brief Return the error payload.
+     *
+     * @return The error payload.
+     */
+    const ErrorPayload &payload() const noexcept
+    {
+        return m_payload;
+    }
+
+
+    /**
+     * @brief Return the error code.
+     *
+     * @return The error code.
+     */
+    ErrorCode code() const noexcept
+    {
+        return m_payload.code;
+    }
+
+
+    /**
+     * @brief Return the error message.
+     *
+     * @return The null-terminated error message, prefixed with "Error: ".
+     */
+    const char *what() const noexcept override
+    {
+        return (m_what[0] != '\0') ? m_what.data() : std::runtime_error::what();
+    }
+
+
+private:
+    /// The error payload
+    ErrorPayload m_payload;
+
+    /// The rendered payload message, empty for errors with a custom message
+    std::array<char, 256> m_what;
 };
 
 
@@ -32,13 +275,28 @@ public:
 class CommandLineArgumentError: public Error
 {
 public:
+    /// The error code of this error class.
+    static constexpr ErrorCode error_code = ErrorCode::ArgumentNotFound;
+
+
     /**
      * @brief c'tor
      *
      * @param message The error message.
      */
     explicit CommandLineArgumentError(const std::string &message)
-        : Error(message)
+        : Error(message, error_code)
+    {
+    }
+
+
+    /**
+     * @brief c'tor
+     *
+     * @param payload The error payload.
+     */
+    explicit CommandLineArgumentError(const ErrorPayload &payload)
+        : Error(payload)
     {
     }
 };
@@ -50,18 +308,227 @@ public:
 class CommandLineOptionError : public Error
 {
 public:
+    /// The error code of this error class.
+    static constexpr ErrorCode error_code = ErrorCode::InvalidValue;
+
+
     /**
      * @brief c'tor
      *
      * @param message The error message.
      */
     explicit CommandLineOptionError(const std::string &message)
-        : Error(message)
+        : Error(message, error_code)
+    {
+    }
+
+
+    /**
+     * @brief c'tor
+     *
+     * @param payload The error payload.
+     */
+    explicit CommandLineOptionError(const ErrorPayload &payload)
+        : Error(payload)
     {
     }
 };
 
 
+/**
+ * @brief Error class for command string syntax errors.
+ */
+class CommandLineSyntaxError : public Error
+{
+public:
+    /// The error code of this error class.
+    static constexpr ErrorCode error_code = ErrorCode::SyntaxError;
+
+
+    /**
+     * @brief c'tor
+     *
+     * @param message The error message.
+     */
+    explicit CommandLineSyntaxError(const std::string &message)
+        : Error(message, error_code)
+    {
+    }
+
+
+    /**
+     * @brief c'tor
+     *
+     * @param payload The error payload.
+     */
+    explicit CommandLineSyntaxError(const ErrorPayload &payload)
+        : Error(payload)
+    {
+    }
+};
+
+
+#if defined(CPPARGPARSE_NO_EXCEPTIONS)
+/**
+ * @brief The error handler type, see set_error_handler().
+ */
+typedef void (*ErrorHandler)(const ErrorPayload &payload);
+
+
+/**
+ * @brief The error state of the calling thread.
+ */
+struct ErrorState
+{
+    /// The last error raised on this thread.
+    ErrorPayload last_error;
+
+    /// The number of active capture() calls on this thread.
+    size_t captures;
+};
+
+
+/**
+ * @brief Return the error state of the calling thread.
+ *
+ * @return The error state.
+ */
+inline ErrorState &error_state()
+{
+    thread_local ErrorState state { make_payload(ErrorCode::None, no_index, no_index, nullptr, std::string_view()), 0 };
+    return state;
+}
+
+
+/**
+ * @brief Return the installed error handler.
+ *
+ * @return The error handler, nullptr by default.
+ */
+inline ErrorHandler &error_handler()
+{
+    static ErrorHandler handler = nullptr;
+    return handler;
+}
+
+
+/**
+ * @brief Install a handler to call with every failure, e.g. to print the message and exit.
+ *
+ * If the handler returns, the failing function returns a value-initialized value.
+ *
+ * @param handler The error handler or nullptr to only record failures.
+ *
+ * @return The previous error handler.
+ */
+inline ErrorHandler set_error_handler(ErrorHandler handler)
+{
+    const ErrorHandler previous = error_handler();
+    error_handler() = handler;
+
+    return previous;
+}
+
+
+/**
+ * @brief Return the last error raised on the calling thread.
+ *
+ * @return The last error payload, ErrorCode::None if there was none since clear_error().
+ */
+inline const ErrorPayload &last_error()
+{
+    return error_state().last_error;
+}
+
+
+/**
+ * @brief Forget the last error raised on the calling thread.
+ */
+inline void clear_error()
+{
+    error_state().last_error = make_payload(ErrorCode::None, no_index, no_index, nullptr, std::string_view());
+}
+#endif
+
+
+template <typename ErrorType>
+/**
+ * @brief Report a failure.
+ *
+ * Throws the error, or records it and calls the error handler if CPPARGPARSE_NO_EXCEPTIONS is defined.
+ * The caller must return right after, with a value-initialized value if it has to return one.
+ *
+ * @tparam ErrorType The error class to throw.
+ *
+ * @param payload The error payload.
+ *
+ * @throws ErrorType
+ */
+void raise(const ErrorPayload &payload)
+{
+#if defined(CPPARGPARSE_NO_EXCEPTIONS)
+    ErrorState &state = error_state();
+
+    // Execution carries on after raising, inside capture() only the first error counts, as if it had been thrown
+    if (state.captures == 0 || state.last_error.code == ErrorCode::None)
+    {
+        state.last_error = payload;
+    }
+
+    if (state.captures == 0 && error_handler() != nullptr)
+    {
+        error_handler()(payload);
+    }
+#else
+    throw ErrorType(payload);
+#endif
+}
+
+
+template <typename Function>
+/**
+ * @brief Call a function and return the code of the first error it raises instead of propagating it.
+ *
+ * The error handler isn't called for captured errors.
+ *
+ * @tparam Function The function type, called without arguments.
+ *
+ * @param function The function.
+ *
+ * @return The error code, ErrorCode::None if the function succeeded.
+ */
+ErrorCode capture(Function &&function)
+{
+#if defined(CPPARGPARSE_NO_EXCEPTIONS)
+    ErrorState &state = error_state();
+    const ErrorPayload outer_error = state.last_error;
+
+    state.last_error.code = ErrorCode::None;
+    ++state.captures;
+
+    function();
+
+    --state.captures;
+    const ErrorCode code = state.last_error.code;
+    state.last_error = outer_error;
+
+    return code;
+#else
+    try
+    {
+        function();
+    }
+
+    catch (const Error &error)
+    {
+        return error.code();
+    }
+
+    return ErrorCode::None;
+#endif
+}
+
+
 } // namespace errors
 } // namespace cppargparse
 
@@ -0,0 +1,297 @@
+#ifndef CPPARGPARSE_FLAT_MAP_H
+#define CPPARGPARSE_FLAT_MAP_H
+
+/**
+  @file cppargparse/flat_map.h
+  @brief A flat open-addressing hash map with string keys, e.g. for "-D key=value" definitions.
+ */
+
+
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+
+namespace cppargparse {
+namespace containers {
+
+
+template <typename T>
+/**
+ * @brief A hash map from strings to values of type T, stored in two flat arrays.
+ *
+ * The entries are kept in insertion order in one array. A power-of-two table of entry indices,
+ * probed linearly and kept at most half full, maps keys to them. Lookups accept any string view,
+ * so looking a key up never allocates.
+ *
+ * @tparam T The value type.
+ */
+class FlatMap
+{
+public:
+    /// The key type.
+    typedef std::string key_type;
+
+    /// The value type.
+    typedef T mapped_type;
+
+    /// The entry type.
+    typedef std::pair<std::string, T> value_type;
+
+    /// The entry iterator type, iterating in insertion order.
+    typedef typename std::vector<value_type>::iterator iterator;
+
+    /// The constant entry iterator type, iterating in insertion order.
+    typedef typename std::vector<value_type>::const_iterator const_iterator;
+
+
+    /**
+     * @brief Return the number of entries.
+     *
+     * @return The number of entries.
+     */
+    size_t size() const
+    {
+        return m_entries.size();
+    }
+
+
+    /**
+     * @brief Return whether there are no entries.
+     *
+     * @return Whether there are no entries.
+     */
+    bool empty() const
+    {
+        return m_entries.empty();
+    }
+
+
+    /**
+     * @brief Make room for a number of entries, so inserting them neither reallocates nor rehashes.
+     *
+     * @param count The number of entries.
+     */
+    void reserve(const size_t count)
+    {
+        m_entries.reserve(count);
+
+        if (slot_count(count) > m_slots.size())
+        {
+            rehash(slot_count(count));
+        }
+    }
+
+
+    /**
+     * @brief Insert an entry or assign the value of an existing entry.
+     *
+     * @param key The key, moved into the map if it isn't there yet.
+     * @param value The value.
+     *
+     * @return The entry and whether it has been inserted.
+     */
+    std::pair<iterator, bool> insert_or_assign(std::string &&key, T &&value)
+    {
+        const size_t hash = std::hash<std::string_view>()(key);
+        const size_t slot = find_slot(key, hash);
+
+        if (m_slots[slot].index != empty_slot)
+        {
+            m_entries[m_slots[slot].index].second = std::move(value);
+            return { m_entries.begin() + static_cast<std::ptrdiff_t>(m_slots[slot].index), false };
+        }
+
+        m_entries.emplace_back(std::move(key), std::move(value));
+        m_slots[slot] = Slot { hash, m_entries.size() - 1 };
+
+        if (slot_count(m_entries.size()) > m_slots.size())
+        {
+            rehash(slot_count(m_entries.size()));
+        }
+
+        return { std::prev(m_entries.end()), true };
+    }
+
+
+    /**
+     * @brief Find an entry.
+     *
+     * @param key The key.
+     *
+     * @return The entry or end() if there is none.
+     */
+    const_iterator find(const std::string_view &key) const
+    {
+        if (m_slots.empty())
+        {
+            return m_entries.cend();
+        }
+
+        const size_t index = m_slots[find_slot(key, std::hash<std::string_view>()(key))].index;
+        return (index == empty_slot) ? m_entries.cend() : m_entries.cbegin() + static_cast<std::ptrdiff_t>(index);
+    }
+
+
+    /**
+     * @brief Return whether there is an entry for a key.
+     *
+     * @param key The key.
+     *
+     * @return Whether there is an entry.
+     */
+    bool contains(const std::string_view &key) const
+    {
+        return find(key) != m_entries.cend();
+    }
+
+
+    /**
+     * @brief Return the first entry.
+     *
+     * @return The iterator of the first inserted entry.
+     */
+    const_iterator begin() const
+    {
+        return m_entries.cbegin();
+    }
+
+
+    /**
+     * @brief Return the end of the entries.
+     *
+     * @return The iterator past the last inserted entry.
+     */
+    const_iterator end() const
+    {
+        return m_entries.cend();
+    }
+
+
+private:
+    /**
+     * @brief An entry of the index table.
+     */
+    struct Slot
+    {
+        /// The hash of the entry's key, compared before the key itself.
+        size_t hash;
+
+        /// The index of the entry or empty_slot.
+        size_t index;
+    };
+
+
+    /// The index of unused slots.
+    static constexpr size_t empty_slot = std::numeric_limits<size_t>::max();
+
+
+    /**
+     * @brief Return the size of the index table for a number of entries.
+     *
+     * @param count The number of entries.
+     *
+     * @return The smallest power of two of at least twice the number of entries, at least 8.
+     */
+    static size_t slot_count(const size_t count)
+    {
+        size_t slots = 8;
+
+        while (slots < count * 2)
+        {
+            slots *= 2;
+        }
+
+        return slots;
+    }
+
+
+    /**
+     * @brief Find the slot of a key, growing the table if it is empty.
+     *
+     * @param key The key.
+     * @param hash The hash of the key.
+     *
+     * @return The slot holding the key or the empty slot it would go into.
+     */
+    size_t find_slot(const std::string_view &key, const size_t hash)
+    {
+        if (m_slots.empty())
+        {
+            rehash(slot_count(0));
+        }
+
+        return static_cast<const FlatMap &>(*this).find_slot(key, hash);
+    }
+
+
+    /**
+     * @brief Find the slot of a key in a non-empty table.
+     *
+     * @param key The key.
+     * @param hash The hash of the key.
+     *
+     * @return The slot holding the key or the empty slot it would go into.
+     */
+    size_t find_slot(const std::string_view &key, const size_t hash) const
+    {
+        const size_t mask = m_slots.size() - 1;
+
+        for (size_t slot = hash & mask; ; slot = (slot + 1) & mask)
+        {
+            const Slot &candidate = m_slots[slot];
+
+            if (candidate.index == empty_slot || (candidate.hash == hash && m_entries[candidate.index].first == key))
+            {
+                return slot;
+            }
+        }
+    }
+
+
+    /**
+     * @brief Rebuild the index table with a new size.
+     *
+     * @param slots The new number of slots, a power of two.
+     */
+    void rehash(const size_t slots)
+    {
+        std::vector<Slot> rehashed(slots, Slot { 0, empty_slot });
+
+        for (const Slot &entry : m_slots)
+        {
+            if (entry.index == empty_slot)
+            {
+                continue;
+            }
+
+            size_t slot = entry.hash & (slots - 1);
+
+            while (rehashed[slot].index != empty_slot)
+            {
+                slot = (slot + 1) & (slots - 1);
+            }
+
+            rehashed[slot] = entry;
+        }
+
+        m_slots.swap(rehashed);
+    }
+
+
+    /// The entries in insertion order.
+    std::vector<value_type> m_entries;
+
+    /// The index table, a power of two in size and at most half full.
+    std::vector<Slot> m_slots;
+};
+
+
+} // namespace containers
+} // namespace cppargparse
+
+#endif // CPPARGPARSE_FLAT_MAP_H
@@ -0,0 +1,230 @@
+#ifndef CPPARGPARSE_LAYOUT_H
+#define CPPARGPARSE_LAYOUT_H
+
+/**
+  @file cppargparse/layout.h
+  @brief The usage string layout, shared by the runtime and the compile-time usage string.
+ */
+
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+
+#include "utf8.h"
+
+
+namespace cppargparse {
+namespace layout {
+
+
+/// The usage string header, followed by the application description.
+static constexpr std::string_view header = "Usage: ";
+
+/// The indentation of the argument lines.
+static constexpr std::string_view indent = "  ";
+
+/// The separator between the ID and the alternative ID.
+static constexpr char id_separator = '|';
+
+/// The minimum number of spaces between the ID column and the description column.
+static constexpr size_t spacing = 3;
+
+
+/**
+ * @brief The usage information of an argument, known at compile time.
+ */
+struct ArgumentSpec
+{
+    /// The argument ID.
+    std::string_view id;
+
+    /// The alternative argument ID, may be empty.
+    std::string_view id_alt;
+
+    /// The argument description, may be empty.
+    std::string_view description;
+};
+
+
+/**
+ * @brief Return the display width of an argument's "<ID>|<alternative ID>" usage column.
+ *
+ * @param id The argument ID.
+ * @param id_alt The alternative argument ID.
+ *
+ * @return The column width.
+ */
+constexpr size_t id_width(const std::string_view &id, const std::string_view &id_alt)
+{
+    return utf8::display_width_scalar(id) + (id_alt.empty() ? 0 : 1 + utf8::display_width_scalar(id_alt));
+}
+
+
+template <size_t N>
+/**
+ * @brief Return the maximum display width of the "<ID>|<alternative ID>" usage columns.
+ *
+ * @tparam N The number of arguments.
+ *
+ * @param arguments The arguments.
+ *
+ * @return The maximum column width.
+ */
+constexpr size_t max_id_width(const ArgumentSpec (&arguments)[N])
+{
+    size_t width = 0;
+
+    for (const auto &argument : arguments)
+    {
+        const size_t argument_width = id_width(argument.id, argument.id_alt);
+        width = (argument_width > width) ? argument_width : width;
+    }
+
+    return width;
+}
+
+
+template <size_t N>
+/**
+ * @brief Return the length of the usage string.
+ *
+ * @tparam N The number of arguments.
+ *
+ * @param description The application description.
+ * @param arguments The arguments.
+ *
+ * @return The number of characters of the usage string.
+ */
+constexpr size_t usage_length(const std::string_view &description, const ArgumentSpec (&arguments)[N])
+{
+    const size_t column = max_id_width(arguments) + spacing;
+    size_t length = header.size() + description.size() + 2;
+
+    for (const auto &argument : arguments)
+    {
+        length += indent.size() + argument.id.size() + (argument.id_alt.empty() ? 0 : 1 + argument.id_alt.size())
+                + column - id_width(argument.id, argument.id_alt) + argument.description.size() + 1;
+    }
+
+    return length;
+}
+
+
+template <size_t Length>
+/**
+ * @brief A usage string rendered at compile time.
+ *
+ * @tparam Length The number of characters, without the terminating null character.
+ */
+struct StaticUsage
+{
+    /// The null-terminated characters.
+    std::array<char, Length + 1> text;
+
+
+    /**
+     * @brief Return the usage string.
+     *
+     * @return A view of the characters, valid as long as the object.
+     */
+    constexpr std::string_view view() const
+    {
+        return std::string_view(text.data(), Length);
+    }
+
+
+    /**
+     * @brief Return the null-terminated usage string.
+     *
+     * @return The characters, valid as long as the object.
+     */
+    constexpr const char *c_str() const
+    {
+        return text.data();
+    }
+
+
+    /**
+     * @brief Return the length of the usage string.
+     *
+     * @return The number of characters, without the terminating null character.
+     */
+    constexpr size_t size() const
+    {
+        return Length;
+    }
+};
+
+
+template <const std::string_view &Description, const auto &Arguments>
+/**
+ * @brief Render a usage string at compile time.
+ *
+ * The layout matches #cppargparse::parser::ArgumentParser::usage() for the same arguments, in the same order:
+ *
+ *     static constexpr std::string_view description = "Application";
+ *     static constexpr cppargparse::layout::ArgumentSpec arguments[] = {
+ *         {"-h", "--help", "Display this information"},
+ *         {"-t", "--time", "The time"}
+ *     };
+ *
+ *     static constexpr auto usage = cppargparse::layout::make_usage<description, arguments>();
+ *     write(STDOUT_FILENO, usage.c_str(), usage.size());
+ *
+ * @tparam Description The application description, a std::string_view with static storage duration.
+ * @tparam Arguments The arguments, an ArgumentSpec array with static storage duration.
+ *
+ * @return The rendered usage string.
+ */
+constexpr auto make_usage()
+{
+    constexpr size_t column = max_id_width(Arguments) + spacing;
+    StaticUsage<usage_length(Description, Arguments)> usage {};
+
+    size_t length = 0;
+
+    const auto append = [&](const std::string_view &text)
+    {
+        for (const char c : text)
+        {
+            usage.text[length++] = c;
+        }
+    };
+
+    const auto fill = [&](const char c, size_t count)
+    {
+        while (count-- != 0)
+        {
+            usage.text[length++] = c;
+        }
+    };
+
+    append(header);
+    append(Description);
+    fill('\n', 2);
+
+    for (const auto &argument : Arguments)
+    {
+        append(indent);
+        append(argument.id);
+
+        if (!argument.id_alt.empty())
+        {
+            fill(id_separator, 1);
+            append(argument.id_alt);
+        }
+
+        fill(' ', column - id_width(argument.id, argument.id_alt));
+        append(argument.description);
+        fill('\n', 1);
+    }
+
+    return usage;
+}
+
+
+} // namespace layout
+} // namespace cppargparse
+
+#endif // CPPARGPARSE_LAYOUT_H
@@ -0,0 +1,381 @@
+#ifndef CPPARGPARSE_LEXER_H
+#define CPPARGPARSE_LEXER_H
+
+/**
+  @file cppargparse/lexer.h
+  @brief Single-pass command line lexer splitting registered option clusters and joined values.
+ */
+
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+
+#include "cmd.h"
+
+
+namespace cppargparse {
+namespace lexer {
+
+
+/**
+ * @brief Build the static storage for the one-letter option IDs produced by short option clusters.
+ *
+ * Entry c occupies the characters [2 * c, 2 * c + 2) and reads "-c".
+ *
+ * @return The short option ID storage.
+ */
+constexpr std::array<char, 512> make_short_option_ids()
+{
+    std::array<char, 512> ids {};
+
+    for (size_t c = 0; c < 256; ++c)
+    {
+        ids[2 * c] = '-';
+        ids[2 * c + 1] = static_cast<char>(c);
+    }
+
+    return ids;
+}
+
+
+/// The static storage for the one-letter option IDs produced by short option clusters.
+/// Views into it stay valid for the lifetime of the program.
+static constexpr std::array<char, 512> short_option_ids = make_short_option_ids();
+
+
+/**
+ * @brief Return the one-letter option ID for a cluster character.
+ *
+ * @param c The option character.
+ *
+ * @return A view of "-c" into static storage.
+ */
+inline std::string_view short_option_id(const char c)
+{
+    return std::string_view(short_option_ids.data() + 2 * static_cast<unsigned char>(c), 2);
+}
+
+
+/**
+ * @brief The options terminator. Tokens after it are never treated as options.
+ */
+static constexpr std::string_view terminator = "--";
+
+
+/**
+ * @brief The prefix negating a long boolean option, e.g. "--no-cache" for "--cache".
+ */
+static constexpr std::string_view negation_prefix = "--no-";
+
+
+/**
+ * @brief Return whether a token negates a long option.
+ *
+ * @param token The command line token.
+ * @param id The long option ID, e.g. "--cache".
+ *
+ * @return Whether the token is the option ID with "--" replaced by "--no-", e.g. "--no-cache".
+ */
+constexpr bool is_negation(const std::string_view &token, const std::string_view &id)
+{
+    return id.size() > 2 && id.substr(0, 2) == terminator && token.size() == id.size() + 3
+            && token.substr(0, negation_prefix.size()) == negation_prefix
+            && token.substr(negation_prefix.size()) == id.substr(2);
+}
+
+
+/**
+ * @brief Return whether a character is an ASCII letter.
+ *
+ * @param c The character.
+ *
+ * @return Whether the character is an ASCII letter.
+ */
+constexpr bool is_letter(const char c)
+{
+    return static_cast<unsigned char>((c | 0x20) - 'a') < 26;
+}
+
+
+/**
+ * @brief Return whether a token is shaped like a short option cluster, e.g. "-xvf".
+ *
+ * A cluster starts with a single dash followed by at least two letters and nothing else.
+ * It is only expanded if every letter is a registered one-letter option, see option_length().
+ *
+ * @param token The command line token.
+ *
+ * @return Whether the token is shaped like a short option cluster.
+ */
+constexpr bool is_cluster(const std::string_view &token)
+{
+    if (token.size() < 3 || token[0] != '-' || token[1] == '-')
+    {
+        return false;
+    }
+
+    for (size_t i = 1; i < token.size(); ++i)
+    {
+        if (!is_letter(token[i]))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+/**
+ * @brief Return the position of the "=" separating an option from its value.
+ *
+ * Only tokens starting with "-" followed by a letter or a second dash can carry a joined value,
+ * so negative numbers and plain values are never split.
+ *
+ * @param token The command line token.
+ *
+ * @return The separator position or std::string_view::npos if the token carries no joined value.
+ */
+constexpr size_t joined_value_separator(const std::string_view &token)
+{
+    if (token.size() < 3 || token[0] != '-' || !(token[1] == '-' || is_letter(token[1])))
+    {
+        return std::string_view::npos;
+    }
+
+    // "--=value" has no option name to join the value to
+    const size_t separator = token.find('=');
+    return (separator == 2 && token[1] == '-') ? std::string_view::npos : separator;
+}
+
+
+/**
+ * @brief Return whether a token is one of the IDs of a range of registered arguments.
+ *
+ * @param token The command line token.
+ * @param first The first registered argument.
+ * @param last The end of the registered arguments.
+ *
+ * @return Whether the token is an ID of one of the arguments.
+ */
+inline bool is_registered(const std::string_view &token, cmd::CommandLineArgumentPosition_t first, const cmd::CommandLineArgumentPosition_t &last)
+{
+    for (; first != last; ++first)
+    {
+        if (cmd::is_arg_id(token, first->id(), first->id_alt()))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+/**
+ * @brief Return how a token splits into an option ID and a value, given the registered arguments.
+ *
+ * In order of precedence:
+ *  - a registered ID stays whole, e.g. "-name" or "-Werror"
+ *  - a cluster whose letters are all registered one-letter options is expanded, e.g. "-xvf"
+ *  - a registered ID joined to a value by "=" is split, e.g. "--threads=8"
+ *  - a registered one-letter option followed by its value is split, e.g. "-Dlevel=3" or "-j8"
+ *  - everything else stays whole
+ *
+ * @param token The command line token.
+ * @param first The first registered argument.
+ * @param last The end of the registered arguments.
+ *
+ * @return The length of the option ID, followed by its value with a leading "=" dropped,
+ *         token.size() if the token stays whole or std::string_view::npos for a cluster.
+ */
+inline size_t option_length(const std::string_view &token, const cmd::CommandLineArgumentPosition_t &first, const cmd::CommandLineArgumentPosition_t &last)
+{
+    if (token.size() < 3 || token[0] != '-' || is_registered(token, first, last))
+    {
+        return token.size();
+    }
+
+    if (is_cluster(token))
+    {
+        bool expanded = true;
+
+        for (size_t i = 1; i < token.size() && expanded; ++i)
+        {
+            expanded = is_registered(short_option_id(token[i]), first, last);
+        }
+
+        if (expanded)
+        {
+            return std::string_view::npos;
+        }
+    }
+
+    const size_t separator = joined_value_separator(token);
+
+    if (separator != std::string_view::npos && is_registered(token.substr(0, separator), first, last))
+    {
+        return separator;
+    }
+
+    if (is_letter(token[1]) && is_registered(token.substr(0, 2), first, last))
+    {
+        return 2;
+    }
+
+    return token.size();
+}
+
+
+/**
+ * @brief Return whether registering an ID can change how a token is lexed, see option_length().
+ *
+ * @param token The command line token.
+ * @param id The argument ID.
+ *
+ * @return Whether the token starts with the ID or is a cluster containing the ID's letter.
+ */
+inline bool depends_on(const std::string_view &token, const std::string_view &id)
+{
+    if (id.empty())
+    {
+        return false;
+    }
+
+    return token.substr(0, id.size()) == id
+            || (id.size() == 2 && id[0] == '-' && is_cluster(token) && token.find(id[1], 1) != std::string_view::npos);
+}
+
+
+/**
+ * @brief The command line lexer.
+ *
+ * Appends normalised tokens to a command line without allocating new strings.
+ * Only registered IDs are split off, see option_length():
+ *  - "--threads=8" becomes "--threads", "8" (views into the original token)
+ *  - "-xvf" becomes "-x", "-v", "-f" (views into static storage)
+ *  - "-Dlevel=3" becomes "-D", "level=3"
+ *  - everything after the "--" terminator is appended verbatim
+ */
+class Lexer
+{
+public:
+    /**
+     * @brief c'tor
+     *
+     * @param cmd The command line to append the normalised tokens to.
+     * @param cmdargs The registered command line arguments. Must outlive the lexer.
+     */
+    Lexer(cmd::CommandLine_t &cmd, const cmd::CommandLineArguments_t &cmdargs)
+        : m_cmd(cmd)
+        , m_first(cmdargs.cbegin())
+        , m_last(cmdargs.cend())
+        , m_terminated(false)
+    {
+    }
+
+
+    /**
+     * @brief Return the number of normalised tokens lex() would append for a raw command line token.
+     *
+     * @param token The raw command line token.
+     *
+     * @return The number of normalised tokens.
+     */
+    size_t count(const std::string_view &token) const
+    {
+        if (m_terminated)
+        {
+            return 1;
+        }
+
+        const size_t length = option_length(token, m_first, m_last);
+        return (length == std::string_view::npos) ? token.size() - 1 : (length == token.size()) ? 1 : 2;
+    }
+
+
+    /**
+     * @brief Normalise a raw command line token.
+     *
+     * @param token The raw command line token. Must outlive the command line.
+     */
+    void lex(const std::string_view &token)
+    {
+        if (m_terminated)
+        {
+            m_cmd.emplace_back(token);
+            return;
+        }
+
+        if (token == terminator)
+        {
+            m_terminated = true;
+            m_cmd.emplace_back(token);
+            return;
+        }
+
+        const size_t length = option_length(token, m_first, m_last);
+
+        if (length == std::string_view::npos)
+        {
+            for (size_t i = 1; i < token.size(); ++i)
+            {
+                m_cmd.emplace_back(short_option_id(token[i]));
+            }
+
+            return;
+        }
+
+        if (length != token.size())
+        {
+            m_cmd.emplace_back(token.substr(0, length));
+            m_cmd.emplace_back(token.substr(token[length] == '=' ? length + 1 : length));
+            return;
+        }
+
+        m_cmd.emplace_back(token);
+    }
+
+
+private:
+    /// The command line the normalised tokens are appended to.
+    cmd::CommandLine_t &m_cmd;
+
+    /// The first registered argument.
+    cmd::CommandLineArgumentPosition_t m_first;
+
+    /// The end of the registered arguments.
+    cmd::CommandLineArgumentPosition_t m_last;
+
+    /// Whether the "--" terminator has been seen.
+    bool m_terminated;
+};
+
+
+template <typename InputIt>
+/**
+ * @brief Normalise a range of raw command line tokens.
+ *
+ * @tparam InputIt The input iterator type. Must dereference to something convertible to std::string_view.
+ *
+ * @param first The first raw token.
+ * @param last The end of the raw token range.
+ * @param cmdargs The registered command line arguments.
+ * @param cmd The command line to append the normalised tokens to.
+ */
+void lex(InputIt first, InputIt last, const cmd::CommandLineArguments_t &cmdargs, cmd::CommandLine_t &cmd)
+{
+    Lexer lexer(cmd, cmdargs);
+
+    for (; first != last; ++first)
+    {
+        lexer.lex(std::string_view(*first));
+    }
+}
+
+
+} // namespace lexer
+} // namespace cppargparse
+
+#endif // CPPARGPARSE_LEXER_H
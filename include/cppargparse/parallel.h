@@ -0,0 +1,207 @@
+#ifndef CPPARGPARSE_PARALLEL_H
+#define CPPARGPARSE_PARALLEL_H
+
+/**
+  @file cppargparse/parallel.h
+  @brief Opt-in parallel conversion of very large container options.
+ */
+
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include "errors.h"
+
+#if !defined(CPPARGPARSE_NO_EXCEPTIONS)
+#include <exception>
+#include <system_error>
+#endif
+
+
+namespace cppargparse {
+namespace parallel {
+
+
+/**
+ * @brief How container options are split across threads.
+ */
+struct ConversionPolicy
+{
+    /// The maximum number of threads converting one option, including the calling thread. 1 converts sequentially.
+    size_t threads;
+
+    /// The minimum number of command line tokens per thread, so small options don't pay for starting threads.
+    size_t min_chunk_size;
+};
+
+
+/**
+ * @brief Return the installed conversion policy.
+ *
+ * @return The conversion policy, sequential by default.
+ */
+inline ConversionPolicy &conversion_policy()
+{
+    static ConversionPolicy policy { 1, 65536 };
+    return policy;
+}
+
+
+/**
+ * @brief Install the conversion policy for all parsers.
+ *
+ * Install it before parsing, e.g. at the start of main():
+ *
+ *     cppargparse::parallel::set_conversion_policy({std::thread::hardware_concurrency(), 65536});
+ *
+ * @param policy The conversion policy.
+ *
+ * @return The previously installed conversion policy.
+ */
+inline ConversionPolicy set_conversion_policy(const ConversionPolicy &policy)
+{
+    const ConversionPolicy previous = conversion_policy();
+    conversion_policy() = policy;
+
+    return previous;
+}
+
+
+/**
+ * @brief Return the installed validation policy.
+ *
+ * It replaces the conversion policy for values whose conversion queries the system, e.g. checked paths,
+ * which pay for threads at far fewer tokens than numbers do.
+ *
+ * @return The validation policy, sequential by default.
+ */
+inline ConversionPolicy &validation_policy()
+{
+    static ConversionPolicy policy { 1, 256 };
+    return policy;
+}
+
+
+/**
+ * @brief Install the validation policy for all parsers.
+ *
+ * Validation waits on the system rather than the CPU, so more threads than cores can pay off:
+ *
+ *     cppargparse::parallel::set_validation_policy({4 * std::thread::hardware_concurrency(), 256});
+ *
+ * @param policy The validation policy.
+ *
+ * @return The previously installed validation policy.
+ */
+inline ConversionPolicy set_validation_policy(const ConversionPolicy &policy)
+{
+    const ConversionPolicy previous = validation_policy();
+    validation_policy() = policy;
+
+    return previous;
+}
+
+
+/**
+ * @brief Return the number of chunks to split a number of tokens into.
+ *
+ * @param tokens The number of tokens.
+ * @param policy The conversion policy.
+ *
+ * @return The number of chunks, at least 1.
+ */
+inline size_t chunk_count(const size_t tokens, const ConversionPolicy &policy)
+{
+    const size_t chunks = tokens / std::max<size_t>(policy.min_chunk_size, 1);
+    return std::max<size_t>(std::min(chunks, policy.threads), 1);
+}
+
+
+template <typename Function>
+/**
+ * @brief Call a function for every chunk index concurrently and wait for all calls to return.
+ *
+ * The calling thread handles chunk 0, every other chunk gets its own thread.
+ * Chunks whose thread can't be started, e.g. because the process is out of threads, run on the calling thread.
+ * If calls throw, the exception of the lowest chunk index is rethrown after all calls have returned.
+ *
+ * @tparam Function The function type, callable with a size_t.
+ * @param chunks The number of chunks.
+ * @param function The function.
+ */
+void for_each_chunk(const size_t chunks, Function &&function)
+{
+#if defined(CPPARGPARSE_NO_EXCEPTIONS)
+    const auto run = [&](const size_t chunk)
+    {
+        function(chunk);
+    };
+#else
+    std::vector<std::exception_ptr> exceptions(chunks);
+
+    const auto run = [&](const size_t chunk)
+    {
+        try
+        {
+            function(chunk);
+        }
+
+        catch (...)
+        {
+            exceptions[chunk] = std::current_exception();
+        }
+    };
+#endif
+
+    std::vector<std::thread> threads;
+    threads.reserve(chunks);
+
+    size_t started = 1;
+
+#if !defined(CPPARGPARSE_NO_EXCEPTIONS)
+    try
+    {
+#endif
+        for (; started < chunks; ++started)
+        {
+            threads.emplace_back(run, started);
+        }
+#if !defined(CPPARGPARSE_NO_EXCEPTIONS)
+    }
+
+    catch (const std::system_error &)
+    {
+        // Out of threads, the chunks from started on run on the calling thread
+    }
+#endif
+
+    run(0);
+
+    for (size_t chunk = started; chunk < chunks; ++chunk)
+    {
+        run(chunk);
+    }
+
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+#if !defined(CPPARGPARSE_NO_EXCEPTIONS)
+    for (const auto &exception : exceptions)
+    {
+        if (exception)
+        {
+            std::rethrow_exception(exception);
+        }
+    }
+#endif
+}
+
+
+} // namespace parallel
+} // namespace cppargparse
+
+#endif // CPPARGPARSE_PARALLEL_H
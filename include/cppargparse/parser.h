@@ -2,13 +2,33 @@
 #define CPPARGPARSE_PARSER_PARSER_H
 
 #include <algorithm>
+#include <array>
+#include <cerrno>
+#include <climits>
 #include <functional>
 #include <iterator>
-#include <sstream>
-
+#include <map>
+#include <memory_resource>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include <cppargparse/algorithm.h>
 #include <cppargparse/arguments.h>
 #include <cppargparse/cmd.h>
 #include <cppargparse/errors.h>
+#include <cppargparse/layout.h>
+#include <cppargparse/lexer.h>
+#include <cppargparse/terminal.h>
+#include <cppargparse/tokenizer.h>
+#include <cppargparse/utf8.h>
 
 
 namespace cppargparse {
@@ -19,6 +39,9 @@ namespace parser {
  * @brief The argument parser class.
  *
  * Used as an interface between the argument value conversion operations and the outside world.
+ *
+ * If CPPARGPARSE_NO_EXCEPTIONS is defined, failures are reported through #cppargparse::errors::raise()
+ * instead of being thrown, and the failing getters return value-initialized values.
  */
 class ArgumentParser
 {
@@ -29,13 +52,94 @@ public:
      * @param argc The command line argument count.
      * @param argv The command line argument array.
      * @param application_description The application description.
+     * @param resource The memory resource used for the command line, its arguments and std::pmr container values.
+     *                 The returned argument handles use the default memory resource and may outlive it.
      */
-    explicit ArgumentParser(int argc, char *argv[], const std::string &description)
-        : m_cmd(cmd::CommandLine_t(argv, argv + argc))
-        , m_cmdargs()
-        , m_positionals()
+    explicit ArgumentParser(int argc, char *argv[], const std::string &description,
+                            std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+        : m_buffer(resource)
+        , m_tokens(resource)
+        , m_cmd(resource)
+        , m_cmdargs(resource)
+        , m_positionals(resource)
+        , m_anchors(resource)
+        , m_expectations(resource)
         , m_description(description)
+        , m_usages()
+        , m_usages_mutex()
+    {
+        assign(argc, argv);
+    }
+
+
+    /**
+     * @brief c'tor
+     *
+     * Splits the command string following POSIX shell quoting rules, see #cppargparse::tokenizer::tokenize().
+     * Unlike argv, the command string must not contain the program name.
+     *
+     * @param command_line The command string.
+     * @param application_description The application description.
+     * @param resource The memory resource used for the command line, its arguments and std::pmr container values.
+     *                 The returned argument handles use the default memory resource and may outlive it.
+     *
+     * @throws #cppargparse::errors::CommandLineSyntaxError if a quote is not closed.
+     */
+    explicit ArgumentParser(const std::string_view &command_line, const std::string &description,
+                            std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+        : m_buffer(resource)
+        , m_tokens(resource)
+        , m_cmd(resource)
+        , m_cmdargs(resource)
+        , m_positionals(resource)
+        , m_anchors(resource)
+        , m_expectations(resource)
+        , m_description(description)
+        , m_usages()
+        , m_usages_mutex()
+    {
+        assign(command_line);
+    }
+
+
+    /**
+     * @brief copy c'tor
+     *
+     * The command line views and argument positions are rebased onto the copied buffer.
+     * The copy uses the same memory resource.
+     *
+     * @param other The argument parser to copy.
+     */
+    ArgumentParser(const ArgumentParser &other)
+        : m_buffer(other.m_buffer, other.resource())
+        , m_tokens(other.resource())
+        , m_cmd(other.resource())
+        , m_cmdargs(other.resource())
+        , m_positionals(other.resource())
+        , m_anchors(other.m_anchors, other.resource())
+        , m_expectations(other.m_expectations, other.resource())
+        , m_description(other.m_description)
+        , m_usages(other.copy_usages())
+        , m_usages_mutex()
     {
+        m_tokens.reserve(other.m_tokens.size());
+
+        for (const auto &token : other.m_tokens)
+        {
+            m_tokens.emplace_back(m_buffer.data() + (token.data() - other.m_buffer.data()), token.size());
+        }
+
+        m_cmd.reserve(other.m_cmd.size());
+
+        for (const auto &token : other.m_cmd)
+        {
+            // Views into static storage (short option clusters) stay as they are
+            const bool owned = token.data() >= other.m_buffer.data() && token.data() <= other.m_buffer.data() + other.m_buffer.size();
+            m_cmd.emplace_back(owned ? std::string_view(m_buffer.data() + (token.data() - other.m_buffer.data()), token.size()) : token);
+        }
+
+        rebase(other.m_cmd, other.m_cmdargs, m_cmdargs);
+        rebase(other.m_cmd, other.m_positionals, m_positionals);
     }
 
 
@@ -51,6 +155,56 @@ public:
     }
 
 
+    /**
+     * @brief Parse another command line with the same argument definitions.
+     *
+     * Registered arguments and positionals are resolved against the new command line,
+     * argument handles returned before stay valid. The storage of the previous command line is reused,
+     * so once it has grown large enough, resetting doesn't allocate.
+     *
+     * @param argc The command line argument count.
+     * @param argv The command line argument array.
+     */
+    void reset(int argc, char *argv[])
+    {
+        m_buffer.clear();
+        m_tokens.clear();
+
+        assign(argc, argv);
+        reposition();
+    }
+
+
+    /**
+     * @brief Parse another command string with the same argument definitions.
+     *
+     * See reset(int, char *[]) and ArgumentParser(const std::string_view &, const std::string &).
+     *
+     * @param command_line The command string.
+     *
+     * @throws #cppargparse::errors::CommandLineSyntaxError if a quote is not closed.
+     */
+    void reset(const std::string_view &command_line)
+    {
+        m_buffer.clear();
+        m_tokens.clear();
+
+        assign(command_line);
+        reposition();
+    }
+
+
+    /**
+     * @brief Return the memory resource used for the command line, its arguments and std::pmr container values.
+     *
+     * @return The memory resource.
+     */
+    std::pmr::memory_resource *resource() const
+    {
+        return m_cmd.get_allocator().resource();
+    }
+
+
     /**
      * @brief Add a positional argument which is neither a flag nor an option.
      *
@@ -66,13 +220,11 @@ public:
      */
     const cmd::CommandLineArgument add_positional(const std::string &description)
     {
-        cmd::CommandLineArgument arg {
-            std::string(), std::string(), description,
-            (m_cmdargs.size() > 0) ? std::next(std::prev(m_cmdargs.cend())->position()) : m_cmd.cbegin()
-        };
+        m_anchors.push_back(m_cmdargs.size());
+        m_positionals.emplace_back(std::string(), std::string(), description, positional_position(m_anchors.back()));
+        m_positionals.back().m_index = m_positionals.size() - 1;
 
-        m_positionals.emplace_back(arg);
-        return arg;
+        return m_positionals.back();
     }
 
 
@@ -106,29 +258,44 @@ public:
      */
     const T get_positional(const cmd::CommandLineArgument &positional)
     {
-        if (positional.position() == m_cmd.cend())
-        {
-            const auto positional_it = std::find(m_positionals.cbegin(), m_positionals.cend(), positional);
-            const auto positional_index = std::distance(m_positionals.cbegin(), positional_it);
-
-            std::ostringstream message;
-            message << "Cannot find positional argument #" << positional_index + 1;
+        const auto &resolved = resolve(positional, m_positionals);
 
-            throw errors::CommandLineArgumentError(message.str());
+        if (resolved.position() == m_cmd.cend())
+        {
+            errors::raise<errors::CommandLineArgumentError>(errors::make_payload(
+                        errors::ErrorCode::ArgumentNotFound, m_cmd.size(), positional.index(), nullptr, std::string_view()));
+            return T();
         }
 
-        return argument<T>::convert(m_cmd, positional.position(), m_cmdargs);
+        return argument<T>::convert(m_cmd, resolved.position(), m_cmdargs);
     }
 
 
     /**
      * @brief Add an argument to the command line arguments list.
      *
+     * The argument's positions are resolved against the command line. If its IDs change how the command line
+     * is lexed, e.g. "-f" completing the cluster "-xvf", the command line is lexed again
+     * and all registered arguments are resolved against it.
+     *
      * @param cmdarg The command line argument struct object.
      */
     void add_arg(const cmd::CommandLineArgument &cmdarg)
     {
         m_cmdargs.emplace_back(cmdarg);
+        m_cmdargs.back().m_index = m_cmdargs.size() - 1;
+
+        m_usages.clear();
+
+        if (changes_lexing(m_cmdargs.back()))
+        {
+            lex();
+            reposition();
+        }
+        else
+        {
+            reposition(m_cmdargs.back());
+        }
     }
 
 
@@ -141,12 +308,7 @@ public:
      */
     const cmd::CommandLineArgument add_arg(const std::string &id)
     {
-        const cmd::CommandLineArgument arg {
-            id, algorithm::find_arg_position(m_cmd, id, std::string())
-        };
-
-        add_arg(arg);
-        return arg;
+        return add_arg(id, std::string(), std::string());
     }
 
 
@@ -160,13 +322,7 @@ public:
      */
     const cmd::CommandLineArgument add_arg(const std::string &id, const std::string &id_alt)
     {
-        const cmd::CommandLineArgument arg {
-            id, id_alt, std::string(),
-            algorithm::find_arg_position(m_cmd, id, id_alt)
-        };
-
-        add_arg(arg);
-        return arg;
+        return add_arg(id, id_alt, std::string());
     }
 
 
@@ -181,13 +337,77 @@ public:
      */
     const cmd::CommandLineArgument add_arg(const std::string &id, const std::string &id_alt, const std::string &description)
     {
-        const cmd::CommandLineArgument arg {
-            id, id_alt, description,
-            algorithm::find_arg_position(m_cmd, id, id_alt)
-        };
+        add_arg(cmd::CommandLineArgument(id, id_alt, description, m_cmd.cend(), resource()));
+        return m_cmdargs.back();
+    }
+
 
-        add_arg(arg);
-        return arg;
+    /**
+     * @brief Add an argument to the command line arguments list.
+     *
+     * Lets the parser and #cppargparse::layout::make_usage() share the same argument definitions.
+     *
+     * @param spec The argument ID, alternative ID and description.
+     *
+     * @return The generated command line argument.
+     */
+    const cmd::CommandLineArgument add_arg(const layout::ArgumentSpec &spec)
+    {
+        return add_arg(std::string(spec.id), std::string(spec.id_alt), std::string(spec.description));
+    }
+
+
+    /**
+     * @brief Add a boolean argument whose long IDs can be negated, e.g. "--no-cache" for "--cache".
+     *
+     * get_option<bool>() and get_option<std::optional<bool>>() read the last occurrence,
+     * so "--cache --no-cache" is false. add_arg() resolves the IDs and their negations in a single command line scan.
+     *
+     * @param id The argument ID.
+     * @param id_alt The alternative argument ID.
+     * @param description The argument description.
+     *
+     * @return The generated command line argument.
+     */
+    const cmd::CommandLineArgument add_bool(const std::string &id, const std::string &id_alt = std::string(), const std::string &description = std::string())
+    {
+        cmd::CommandLineArgument cmdarg(id, id_alt, description, m_cmd.cend(), resource());
+        cmdarg.m_negatable = true;
+
+        add_arg(cmdarg);
+        return m_cmdargs.back();
+    }
+
+
+    template <typename E>
+    /**
+     * @brief Add an enum argument, listing its allowed values in the usage string.
+     *
+     * @tparam E The enum type, declared with #CPPARGPARSE_ENUM_ARGUMENT.
+     *
+     * @param id The argument ID.
+     * @param id_alt The alternative argument ID.
+     * @param description The argument description, followed by the allowed values, e.g. "Mode (fast|safe|debug)".
+     *
+     * @return The generated command line argument.
+     */
+    const cmd::CommandLineArgument add_choice(const std::string &id, const std::string &id_alt = std::string(), const std::string &description = std::string())
+    {
+        const std::string_view choices = enumeration::choices<E>.data();
+
+        std::string text;
+        text.reserve(description.size() + choices.size() + 3);
+
+        if (description.empty())
+        {
+            text.append(choices);
+        }
+        else
+        {
+            text.append(description).append(" (").append(choices).append(1, ')');
+        }
+
+        return add_arg(id, id_alt, text);
     }
 
 
@@ -204,15 +424,16 @@ public:
      */
     const T get_option(const cmd::CommandLineArgument &cmdarg)
     {
-        if (cmdarg.position() == m_cmd.cend())
-        {
-            std::ostringstream message;
-            message << "Cannot find argument: " << cmdarg.id();
+        const auto &resolved = resolve(cmdarg, m_cmdargs);
 
-            throw errors::CommandLineArgumentError(message.str());
+        if (resolved.position() == m_cmd.cend())
+        {
+            errors::raise<errors::CommandLineArgumentError>(errors::make_payload(
+                        errors::ErrorCode::ArgumentNotFound, m_cmd.size(), cmdarg.index(), nullptr, cmdarg.id()));
+            return T();
         }
 
-        return argument<T>::parse(m_cmd, cmdarg.position(), m_cmdargs);
+        return argument<T>::parse(m_cmd, resolved.position(), m_cmdargs);
     }
 
 
@@ -230,15 +451,159 @@ public:
      */
     const T get_option(const cmd::CommandLineArgument &cmdarg, const T &default_value)
     {
-        try
+        T value = default_value;
+
+        if (errors::capture([&]() { value = get_option<T>(cmdarg); }) != errors::ErrorCode::None)
         {
-            return get_option<T>(cmdarg);
+            return default_value;
         }
 
-        catch (const errors::Error &)
+        return value;
+    }
+
+
+    template <typename T>
+    /**
+     * @brief Return the values of every occurrence of an argument.
+     *
+     * Example: "-I a -I b -I c" yields { "a", "b", "c" } for "-I".
+     *
+     * @tparam T The argument type. argument::parse() and argument::convert() must be implemented for T.
+     *
+     * @param cmdarg The command line argument.
+     *
+     * @return The argument values of type T, in command line order. Empty if the argument cannot be found.
+     */
+    const std::vector<T> get_all(const cmd::CommandLineArgument &cmdarg)
+    {
+        const auto &positions = resolve(cmdarg, m_cmdargs).positions();
+
+        std::vector<T> values;
+        values.reserve(positions.size());
+
+        for (const auto &position : positions)
         {
-            return default_value;
+            values.emplace_back(argument<T>::parse(m_cmd, position, m_cmdargs));
+        }
+
+        return values;
+    }
+
+
+    /**
+     * @brief Return how often an argument has been passed to the command line.
+     *
+     * Useful for verbosity flags like "-v -v -v".
+     *
+     * @param cmdarg The command line argument.
+     *
+     * @return The number of occurrences of the argument.
+     */
+    size_t count(const cmd::CommandLineArgument &cmdarg) const
+    {
+        return resolve(cmdarg, m_cmdargs).positions().size();
+    }
+
+
+    template <typename T>
+    /**
+     * @brief Declare the value type of a registered argument, to be checked by validate().
+     *
+     * @tparam T The argument type. argument::parse() and argument::convert() must be implemented for T.
+     *
+     * @param cmdarg The command line argument returned by add_arg() or add_positional().
+     * @param required Whether a missing option is an error. Positional arguments are always required.
+     */
+    void expect(const cmd::CommandLineArgument &cmdarg, bool required = false)
+    {
+        const bool positional = cmdarg.id().empty() && cmdarg.id_alt().empty();
+        m_expectations.push_back(Expectation { cmdarg.index(), positional, required || positional, common::type_name<T>(), &convertible<T> });
+    }
+
+
+    /**
+     * @brief Check every argument declared with expect() against the command line in a single sweep.
+     *
+     * Unlike get_option() and get_positional(), all problems are collected instead of stopping at the first one.
+     * No messages are formatted, see describe().
+     *
+     * @return The diagnostics, empty if the command line is valid.
+     */
+    errors::Diagnostics_t validate() const
+    {
+        errors::Diagnostics_t diagnostics(resource());
+
+        for (const auto &expectation : m_expectations)
+        {
+            const auto &cmdargs = expectation.positional ? m_positionals : m_cmdargs;
+
+            if (expectation.index >= cmdargs.size())
+            {
+                continue;
+            }
+
+            const auto &cmdarg = cmdargs[expectation.index];
+
+            const auto report = [&](const errors::ErrorCode code, const size_t token)
+            {
+                diagnostics.push_back(errors::Diagnostic { code, token, expectation.index, expectation.positional, expectation.expected_type });
+            };
+
+            const auto check = [&](const cmd::CommandLinePosition_t &position)
+            {
+                if (!expectation.convertible(m_cmd, position, m_cmdargs, expectation.positional))
+                {
+                    // Options are reported at their first value token
+                    const auto token = static_cast<size_t>(std::distance(m_cmd.cbegin(), position));
+                    report(errors::ErrorCode::InvalidValue, expectation.positional ? token : token + 1);
+                }
+            };
+
+            if (cmdarg.position() == m_cmd.cend())
+            {
+                if (expectation.required)
+                {
+                    report(errors::ErrorCode::ArgumentNotFound, m_cmd.size());
+                }
+            }
+            else if (expectation.positional)
+            {
+                check(cmdarg.position());
+            }
+            else
+            {
+                std::for_each(cmdarg.positions().cbegin(), cmdarg.positions().cend(), check);
+            }
+        }
+
+        return diagnostics;
+    }
+
+
+    /**
+     * @brief Format the message of a diagnostic returned by validate().
+     *
+     * @param diagnostic The diagnostic.
+     *
+     * @return The diagnostic message.
+     */
+    std::string describe(const errors::Diagnostic &diagnostic) const
+    {
+        std::string_view subject;
+
+        if (diagnostic.code == errors::ErrorCode::InvalidValue && diagnostic.token < m_cmd.size())
+        {
+            subject = m_cmd[diagnostic.token];
+        }
+        else if (!diagnostic.positional && diagnostic.argument < m_cmdargs.size())
+        {
+            subject = m_cmdargs[diagnostic.argument].id();
         }
+
+        const auto payload = errors::make_payload(diagnostic.code, diagnostic.token, diagnostic.argument, diagnostic.expected_type, subject);
+
+        std::array<char, 256> message;
+        return std::string(message.data(), errors::render(payload, message.data(), message.size()));
     }
 
 
@@ -324,7 +689,7 @@ public:
     void with(const std::string &id,
               const std::function<void(const ArgumentParser &, const T &)> &callback)
     {
-        callback(*this, get_option<T>(add_arg(id)));
+        call(add_arg(id), callback);
     }
 
 
@@ -341,7 +706,7 @@ public:
     void with(const std::string &id, const std::string &id_alt,
               const std::function<void(const ArgumentParser &, const T &)> &callback)
     {
-        callback(*this, get_option<T>(add_arg(id, id_alt)));
+        call(add_arg(id, id_alt), callback);
     }
 
 
@@ -359,7 +724,7 @@ public:
     void with(const std::string &id, const std::string &id_alt, const std::string &description,
               const std::function<void(const ArgumentParser &, const T &)> &callback)
     {
-        callback(*this, get_option<T>(add_arg(id, id_alt, description)));
+        call(add_arg(id, id_alt, description), callback);
     }
 
 
@@ -448,58 +813,570 @@ public:
     /**
      * @brief Generate and return the usage string.
      *
-     * @return The generated usage string.
+     * The usage string is rendered once and cached until the next argument is added.
+     * The usage functions may be called concurrently, the cache is guarded by a mutex.
+     *
+     * @return The generated usage string, valid until the next argument is added.
      */
-    const std::string usage() const
+    const std::string &usage() const
     {
-        // Find the maximum (argument ID, argument alternative ID) length
-        size_t max_id_length = 0;
+        return cached_usage(0);
+    }
 
-        for (const auto &cmdarg : m_cmdargs)
+
+    /**
+     * @brief Generate and return the usage string with the descriptions wrapped to a line width.
+     *
+     * Columns are aligned by UTF-8 display width, so wide characters take two columns
+     * and combining marks none. A usage string is cached for every width until the next argument is added.
+     *
+     * @param width The line width in terminal columns, e.g. terminal::width(STDOUT_FILENO).
+     *              0 disables wrapping, as does a width leaving too little room for the descriptions.
+     *
+     * @return The generated usage string, valid until the next argument is added.
+     */
+    const std::string &usage(size_t width) const
+    {
+        return cached_usage(width);
+    }
+
+
+    /**
+     * @brief Write the usage string to a file descriptor.
+     *
+     * Writes the cached usage string directly, without an intermediate copy.
+     * The descriptions are wrapped to the terminal width if the file descriptor refers to a terminal.
+     *
+     * @param fd The file descriptor, e.g. STDOUT_FILENO.
+     *
+     * @return Whether the whole usage string has been written.
+     */
+    bool write_usage(int fd) const
+    {
+        const std::string &text = cached_usage(terminal::width(fd));
+
+        for (size_t written = 0; written < text.size(); )
+        {
+#if defined(_WIN32)
+            const auto result = ::write(fd, text.data() + written, static_cast<unsigned int>(std::min<size_t>(text.size() - written, INT_MAX)));
+#else
+            const auto result = ::write(fd, text.data() + written, text.size() - written);
+#endif
+
+            if (result < 0 && errno == EINTR)
+            {
+                continue;
+            }
+
+            if (result <= 0)
+            {
+                return false;
+            }
+
+            written += static_cast<size_t>(result);
+        }
+
+        return true;
+    }
+
+
+    template <typename OutputIt>
+    /**
+     * @brief Copy the usage string to an output iterator.
+     *
+     * @tparam OutputIt The output iterator type, e.g. std::ostreambuf_iterator<char>.
+     *
+     * @param out The output iterator.
+     * @param width The line width, see usage(size_t).
+     *
+     * @return The output iterator past the last written character.
+     */
+    OutputIt write_usage(OutputIt out, size_t width = 0) const
+    {
+        const std::string &text = cached_usage(width);
+        return std::copy(text.cbegin(), text.cend(), out);
+    }
+
+
+private:
+    /**
+     * @brief Copy the raw command line into the buffer and lex it into the command line.
+     *
+     * @param argc The command line argument count.
+     * @param argv The command line argument array.
+     */
+    void assign(int argc, char *argv[])
+    {
+        // Fill the buffer completely before taking views into it
+        size_t size = 0;
+
+        for (int i = 0; i < argc; ++i)
+        {
+            size += std::char_traits<char>::length(argv[i]);
+        }
+
+        m_buffer.reserve(size);
+
+        for (int i = 0; i < argc; ++i)
+        {
+            m_buffer.append(argv[i]);
+        }
+
+        m_tokens.reserve(static_cast<size_t>(argc));
+
+        for (size_t i = 0, offset = 0; i < static_cast<size_t>(argc); ++i)
+        {
+            const size_t length = std::char_traits<char>::length(argv[i]);
+
+            m_tokens.emplace_back(m_buffer.data() + offset, length);
+            offset += length;
+        }
+
+        lex();
+    }
+
+
+    /**
+     * @brief Copy command line arguments with their positions translated to this parser's command line.
+     *
+     * @param cmd The command line the positions refer to.
+     * @param cmdargs The command line arguments to copy.
+     * @param rebased The command line arguments to append the copies to.
+     */
+    void rebase(const cmd::CommandLine_t &cmd, const cmd::CommandLineArguments_t &cmdargs, cmd::CommandLineArguments_t &rebased) const
+    {
+        const auto translate = [&](const cmd::CommandLinePosition_t &position)
+        {
+            return m_cmd.cbegin() + std::distance(cmd.cbegin(), position);
+        };
+
+        rebased.reserve(cmdargs.size());
+
+        for (const auto &cmdarg : cmdargs)
+        {
+            cmd::CommandLinePositions_t positions(resource());
+            positions.reserve(cmdarg.positions().size());
+            std::transform(cmdarg.positions().cbegin(), cmdarg.positions().cend(), std::back_inserter(positions), translate);
+
+            rebased.emplace_back(cmdarg.id(), cmdarg.id_alt(), cmdarg.description(), translate(cmdarg.position()), positions);
+            rebased.back().m_index = cmdarg.m_index;
+            rebased.back().m_negatable = cmdarg.m_negatable;
+        }
+    }
+
+
+    /**
+     * @brief Copy a command string into the buffer, tokenize and lex it into the command line.
+     *
+     * @param command_line The command string.
+     */
+    void assign(const std::string_view &command_line)
+    {
+        m_buffer.append(command_line);
+
+        tokenizer::tokenize(m_buffer.data(), m_buffer.data() + m_buffer.size(), [&](const std::string_view &token)
+        {
+            m_tokens.emplace_back(token);
+        });
+
+        lex();
+    }
+
+
+    /**
+     * @brief Lex the raw command line tokens into the command line, splitting off the registered IDs.
+     *
+     * Invalidates all argument positions.
+     */
+    void lex()
+    {
+        m_cmd.clear();
+        m_cmd.reserve(m_tokens.size());
+
+        lexer::Lexer lexer(m_cmd, m_cmdargs);
+
+        for (const auto &token : m_tokens)
         {
-            const size_t id_length = cmdarg.id().size() + cmdarg.id_alt().size();
+            lexer.lex(token);
+        }
+    }
 
-            if (id_length > max_id_length)
+
+    /**
+     * @brief Return whether the last registered argument changes how the raw command line tokens are lexed.
+     *
+     * Only tokens which start with one of its IDs or are clusters containing its letter are lexed twice,
+     * with and without the argument.
+     *
+     * @param cmdarg The last registered argument.
+     *
+     * @return Whether a token is split differently since the argument has been registered.
+     */
+    bool changes_lexing(const cmd::CommandLineArgument &cmdarg) const
+    {
+        const auto first = m_cmdargs.cbegin();
+        const auto last = m_cmdargs.cend();
+
+        for (const auto &token : m_tokens)
+        {
+            if (token == lexer::terminator)
             {
-                max_id_length = id_length;
+                break;
             }
+
+            if ((lexer::depends_on(token, cmdarg.id()) || lexer::depends_on(token, cmdarg.id_alt()))
+                    && lexer::option_length(token, first, std::prev(last)) != lexer::option_length(token, first, last))
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+
+    /**
+     * @brief Return the position of a positional argument.
+     *
+     * @param anchor The number of arguments registered before the positional argument.
+     *
+     * @return The command line position next to the position of the last argument registered before it
+     *         or the first command line position if none had been registered.
+     */
+    cmd::CommandLinePosition_t positional_position(const size_t anchor) const
+    {
+        if (anchor == 0)
+        {
+            return m_cmd.cbegin();
+        }
+
+        const auto &position = m_cmdargs[anchor - 1].position();
+        return (position == m_cmd.cend()) ? position : std::next(position);
+    }
+
+
+    /**
+     * @brief Return the usage string for a line width, rendering it if the argument definitions changed.
+     *
+     * @param width The line width, see usage(size_t).
+     *
+     * @return The cached usage string.
+     */
+    const std::string &cached_usage(size_t width) const
+    {
+        // Map nodes never move, so the returned reference stays valid while other widths are rendered
+        const std::lock_guard<std::mutex> lock(m_usages_mutex);
+        auto usage = m_usages.find(width);
+
+        if (usage == m_usages.end())
+        {
+            usage = m_usages.emplace(width, std::string()).first;
+            render_usage(usage->second, width);
+        }
+
+        return usage->second;
+    }
+
+
+    /**
+     * @brief Copy the cached usage strings.
+     *
+     * @return The cached usage strings by line width.
+     */
+    std::map<size_t, std::string> copy_usages() const
+    {
+        const std::lock_guard<std::mutex> lock(m_usages_mutex);
+        return m_usages;
+    }
+
+
+    /**
+     * @brief Render the usage string.
+     *
+     * Lines are laid out as "  <ID>|<alternative ID>   <description>", with the descriptions aligned.
+     * Wrapped description lines continue in the description column.
+     *
+     * @param usage The string to render the usage string into.
+     * @param width The line width, see usage(size_t).
+     */
+    void render_usage(std::string &usage, size_t width) const
+    {
+        using layout::header;
+        using layout::indent;
+        using layout::spacing;
+
+        static constexpr size_t min_description_width = 20;
+
+        // Find the maximum "<ID>|<alternative ID>" display width
+        size_t max_id_width = 0;
+
+        for (const auto &cmdarg : m_cmdargs)
+        {
+            max_id_width = std::max(max_id_width, id_width(cmdarg));
         }
 
-        // Add 3 more spaces
-        max_id_length += 3;
+        const size_t column = indent.size() + max_id_width + spacing;
 
+        if (width < column + min_description_width)
+        {
+            width = 0;
+        }
+
+        // Size the usage string before rendering it, exactly unless wrapping adds line breaks
+        size_t size = header.size() + m_description.size() + 2;
+
+        for (const auto &cmdarg : m_cmdargs)
+        {
+            size += column + cmdarg.id().size() + cmdarg.id_alt().size() + cmdarg.description().size() + 1;
+        }
+
+        usage.clear();
+        usage.reserve(size);
 
-        // Generate the usage string
-        std::ostringstream usage_string;
-        usage_string << "Usage: " << m_description << '\n' << '\n';
+        usage.append(header);
+        append_wrapped(usage, m_description, header.size(), width);
+        usage.append(2, '\n');
 
         for (const auto &cmdarg : m_cmdargs)
         {
-            usage_string << ' ' << ' ' << cmdarg.id();
+            usage.append(indent).append(cmdarg.id());
 
             if (!cmdarg.id_alt().empty())
             {
-                usage_string << '|' << cmdarg.id_alt();
+                usage.append(1, layout::id_separator).append(cmdarg.id_alt());
             }
 
-            for (size_t i = 0; i < max_id_length; ++i)
+            usage.append(max_id_width - id_width(cmdarg) + spacing, ' ');
+            append_wrapped(usage, cmdarg.description(), column, width);
+            usage.append(1, '\n');
+        }
+    }
+
+
+    /**
+     * @brief Append a text, breaking lines between words so no line exceeds a width.
+     *
+     * Line breaks in the text are kept. Words wider than the available room get a line of their own.
+     *
+     * @param usage The string to append the text to.
+     * @param text The UTF-8 text.
+     * @param column The column the text starts at; continuation lines are indented to it.
+     * @param width The line width or 0 to append the text unchanged.
+     */
+    static void append_wrapped(std::string &usage, const std::string_view &text, size_t column, size_t width)
+    {
+        if (width == 0 || column + utf8::display_width(text) <= width)
+        {
+            usage.append(text);
+            return;
+        }
+
+        const auto new_line = [&]()
+        {
+            usage.append(1, '\n').append(column, ' ');
+        };
+
+        size_t line_width = 0;
+
+        for (size_t first = 0; first < text.size(); )
+        {
+            const size_t last = std::min(text.find_first_of(" \n", first), text.size());
+
+            if (last != first)
             {
-                usage_string << ' ';
+                const std::string_view word = text.substr(first, last - first);
+                const size_t word_width = utf8::display_width(word);
+
+                if (line_width != 0 && column + line_width + 1 + word_width > width)
+                {
+                    new_line();
+                    line_width = 0;
+                }
+
+                if (line_width != 0)
+                {
+                    usage.append(1, ' ');
+                    ++line_width;
+                }
+
+                usage.append(word);
+                line_width += word_width;
             }
 
-            if (!cmdarg.description().empty())
+            if (last < text.size() && text[last] == '\n')
             {
-                usage_string << cmdarg.description();
+                new_line();
+                line_width = 0;
             }
 
-            usage_string << '\n';
+            first = last + 1;
         }
+    }
 
-        return usage_string.str();
+
+    /**
+     * @brief Return the display width of an argument's "<ID>|<alternative ID>" usage column.
+     *
+     * @param cmdarg The command line argument.
+     *
+     * @return The column width.
+     */
+    static size_t id_width(const cmd::CommandLineArgument &cmdarg)
+    {
+        return utf8::display_width(cmdarg.id()) + (cmdarg.id_alt().empty() ? 0 : 1 + utf8::display_width(cmdarg.id_alt()));
     }
 
 
-private:
+    /**
+     * @brief Resolve an argument's positions against the current command line.
+     *
+     * Negatable arguments also occur as "--no-<name>" and are positioned at their last occurrence.
+     *
+     * @param cmdarg The registered argument.
+     */
+    void reposition(cmd::CommandLineArgument &cmdarg)
+    {
+        cmdarg.m_positions.clear();
+
+        if (cmdarg.negatable())
+        {
+            algorithm::find_negatable_arg_positions(m_cmd, cmdarg.id(), cmdarg.id_alt(), cmdarg.m_positions);
+            cmdarg.m_position = cmdarg.m_positions.empty() ? m_cmd.cend() : cmdarg.m_positions.back();
+
+            return;
+        }
+
+        algorithm::find_arg_positions(m_cmd, cmdarg.id(), cmdarg.id_alt(), cmdarg.m_positions);
+        cmdarg.m_position = cmdarg.m_positions.empty() ? m_cmd.cend() : cmdarg.m_positions.front();
+    }
+
+
+    /**
+     * @brief Resolve all registered argument positions against the current command line.
+     */
+    void reposition()
+    {
+        for (auto &cmdarg : m_cmdargs)
+        {
+            reposition(cmdarg);
+        }
+
+        for (size_t i = 0; i < m_positionals.size(); ++i)
+        {
+            m_positionals[i].m_position = positional_position(m_anchors[i]);
+        }
+    }
+
+
+    /**
+     * @brief Return the registered counterpart of an argument handle.
+     *
+     * @param cmdarg The argument handle.
+     * @param registered The registered arguments the handle may belong to.
+     *
+     * @return The registered argument with up-to-date positions or the handle itself if it hasn't been registered.
+     */
+    const cmd::CommandLineArgument &resolve(const cmd::CommandLineArgument &cmdarg, const cmd::CommandLineArguments_t &registered) const
+    {
+        if (cmdarg.index() < registered.size())
+        {
+            const auto &candidate = registered[cmdarg.index()];
+
+            if (candidate.id() == cmdarg.id() && candidate.id_alt() == cmdarg.id_alt())
+            {
+                return candidate;
+            }
+        }
+
+        return cmdarg;
+    }
+
+
+    template <typename T>
+    /**
+     * @brief Call a callback with the value of an argument.
+     *
+     * Without exceptions, the callback isn't called if the value cannot be retrieved.
+     *
+     * @tparam T The argument value type.
+     *
+     * @param cmdarg The command line argument.
+     * @param callback The callback to call with the argument's value.
+     */
+    void call(const cmd::CommandLineArgument &cmdarg, const std::function<void(const ArgumentParser &, const T &)> &callback)
+    {
+#if defined(CPPARGPARSE_NO_EXCEPTIONS)
+        errors::clear_error();
+        const T value = get_option<T>(cmdarg);
+
+        if (errors::last_error().code == errors::ErrorCode::None)
+        {
+            callback(*this, value);
+        }
+#else
+        callback(*this, get_option<T>(cmdarg));
+#endif
+    }
+
+
+    template <typename T>
+    /**
+     * @brief Return whether the value of an argument can be converted to T.
+     *
+     * @tparam T The argument type.
+     *
+     * @param cmd The command line.
+     * @param position The argument position.
+     * @param cmdargs The command line arguments.
+     * @param positional Whether the argument is a positional argument, which has no option token to skip.
+     *
+     * @return Whether the conversion succeeds.
+     */
+    static bool convertible(const cmd::CommandLine_t &cmd, const cmd::CommandLinePosition_t &position,
+                            const cmd::CommandLineArguments_t &cmdargs, bool positional)
+    {
+        return errors::capture([&]()
+        {
+            if (positional)
+            {
+                argument<T>::convert(cmd, position, cmdargs);
+            }
+            else
+            {
+                argument<T>::parse(cmd, position, cmdargs);
+            }
+        }) == errors::ErrorCode::None;
+    }
+
+
+    /**
+     * @brief An argument value type declared with expect().
+     */
+    struct Expectation
+    {
+        /// The registration index of the argument.
+        size_t index;
+
+        /// Whether the argument is a positional argument.
+        bool positional;
+
+        /// Whether a missing argument is an error.
+        bool required;
+
+        /// The name of the argument type, see common::type_name().
+        const char *expected_type;
+
+        /// The conversion check, see convertible().
+        bool (*convertible)(const cmd::CommandLine_t &, const cmd::CommandLinePosition_t &, const cmd::CommandLineArguments_t &, bool);
+    };
+
+
+    /// The storage for the characters viewed by the command line
+    std::pmr::string m_buffer;
+
+    /// The raw command line tokens, lexed again when registered IDs change how they split
+    cmd::CommandLine_t m_tokens;
+
     /// The command line
     cmd::CommandLine_t m_cmd;
 
@@ -509,8 +1386,20 @@ private:
     /// The positional command line arguments
     cmd::CommandLineArguments_t m_positionals;
 
+    /// The number of arguments registered before each positional argument, which it is positioned after
+    std::pmr::vector<size_t> m_anchors;
+
+    /// The argument value types to check in validate()
+    std::pmr::vector<Expectation> m_expectations;
+
     /// The application description
     const std::string m_description;
+
+    /// The cached usage strings by line width, cleared when an argument is added
+    mutable std::map<size_t, std::string> m_usages;
+
+    /// Guards m_usages against concurrent usage() calls
+    mutable std::mutex m_usages_mutex;
 };
 
 
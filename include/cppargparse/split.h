@@ -0,0 +1,187 @@
+#ifndef CPPARGPARSE_SPLIT_H
+#define CPPARGPARSE_SPLIT_H
+
+/**
+  @file cppargparse/split.h
+  @brief Splitting delimiter-separated list values, e.g. "--weights=0.1,0.2,0.3".
+ */
+
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+
+namespace cppargparse {
+namespace split {
+
+
+/**
+ * @brief Mark the delimiters among 8 characters.
+ *
+ * @param chars The characters, at least 8.
+ * @param delimiter The delimiter.
+ *
+ * @return The 8 characters with the high bit of every delimiter byte set and all other bits cleared.
+ */
+inline uint64_t delimiter_bytes(const char *chars, const char delimiter)
+{
+    uint64_t chunk;
+    std::memcpy(&chunk, chars, sizeof(chunk));
+
+    // Delimiter bytes become zero, then exactly the zero bytes get their high bit set
+    const uint64_t zeroes = chunk ^ (0x0101010101010101ull * static_cast<unsigned char>(delimiter));
+    return ~(((zeroes & 0x7F7F7F7F7F7F7F7Full) + 0x7F7F7F7F7F7F7F7Full) | zeroes | 0x7F7F7F7F7F7F7F7Full);
+}
+
+
+/**
+ * @brief Return the index of the first delimiter marked by delimiter_bytes().
+ *
+ * @param bytes The marked delimiter bytes, not 0.
+ *
+ * @return The index of the first delimiter among the 8 characters.
+ */
+inline size_t first_delimiter(const uint64_t bytes)
+{
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    return static_cast<size_t>(__builtin_clzll(bytes)) / 8;
+#else
+    return static_cast<size_t>(__builtin_ctzll(bytes)) / 8;
+#endif
+}
+
+
+/**
+ * @brief Find the next delimiter.
+ *
+ * Checks 16 characters at a time if SSE2 is available and 8 characters at a time otherwise.
+ *
+ * @param text The text.
+ * @param delimiter The delimiter.
+ * @param from The position to start searching at.
+ *
+ * @return The position of the next delimiter or std::string_view::npos if there is none.
+ */
+inline size_t find(const std::string_view &text, const char delimiter, size_t from = 0)
+{
+    const char *chars = text.data();
+    const size_t size = text.size();
+
+#if defined(__SSE2__)
+    const __m128i delimiters = _mm_set1_epi8(delimiter);
+
+    for (; from < size && size - from >= 16; from += 16)
+    {
+        const int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(chars + from)), delimiters));
+
+        if (mask != 0)
+        {
+            return from + static_cast<size_t>(__builtin_ctz(static_cast<unsigned int>(mask)));
+        }
+    }
+#endif
+
+    for (; from < size && size - from >= 8; from += 8)
+    {
+        const uint64_t bytes = delimiter_bytes(chars + from, delimiter);
+
+        if (bytes != 0)
+        {
+            return from + first_delimiter(bytes);
+        }
+    }
+
+    for (; from < size; ++from)
+    {
+        if (chars[from] == delimiter)
+        {
+            return from;
+        }
+    }
+
+    return std::string_view::npos;
+}
+
+
+/**
+ * @brief Count the delimiters of a text.
+ *
+ * @param text The text.
+ * @param delimiter The delimiter.
+ *
+ * @return The number of delimiters, one less than the number of values.
+ */
+inline size_t count(const std::string_view &text, const char delimiter)
+{
+    const char *chars = text.data();
+    const size_t size = text.size();
+
+    size_t delimiters = 0;
+    size_t position = 0;
+
+#if defined(__SSE2__)
+    const __m128i pattern = _mm_set1_epi8(delimiter);
+
+    for (; size - position >= 16; position += 16)
+    {
+        const int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(chars + position)), pattern));
+        delimiters += static_cast<size_t>(__builtin_popcount(static_cast<unsigned int>(mask)));
+    }
+#endif
+
+    for (; size - position >= 8; position += 8)
+    {
+        delimiters += static_cast<size_t>(__builtin_popcountll(delimiter_bytes(chars + position, delimiter)));
+    }
+
+    for (; position < size; ++position)
+    {
+        delimiters += (chars[position] == delimiter) ? 1 : 0;
+    }
+
+    return delimiters;
+}
+
+
+template <typename Function>
+/**
+ * @brief Call a function for every value of a delimiter-separated text, in order.
+ *
+ * The values are views into the text. A text without delimiters is a single value,
+ * empty texts and empty values between two delimiters are passed as empty views.
+ *
+ * @tparam Function The function type, callable with a std::string_view.
+ * @param text The text.
+ * @param delimiter The delimiter, '\0' to pass the whole text as a single value.
+ * @param function The function.
+ */
+void for_each(const std::string_view &text, const char delimiter, Function &&function)
+{
+    if (delimiter == '\0')
+    {
+        function(text);
+        return;
+    }
+
+    size_t first = 0;
+
+    for (size_t last = find(text, delimiter); last != std::string_view::npos; last = find(text, delimiter, first))
+    {
+        function(text.substr(first, last - first));
+        first = last + 1;
+    }
+
+    function(text.substr(first));
+}
+
+
+} // namespace split
+} // namespace cppargparse
+
+#endif // CPPARGPARSE_SPLIT_H
@@ -0,0 +1,369 @@
+#ifndef CPPARGPARSE_STATIC_PARSER_H
+#define CPPARGPARSE_STATIC_PARSER_H
+
+/**
+  @file cppargparse/static_parser.h
+  @brief Fixed-capacity argument parser which doesn't allocate heap memory while parsing.
+ */
+
+
+#include <array>
+#include <cstddef>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+
+#include <cppargparse/algorithm.h>
+#include <cppargparse/arguments.h>
+#include <cppargparse/cmd.h>
+#include <cppargparse/errors.h>
+#include <cppargparse/lexer.h>
+#include <cppargparse/split.h>
+#include <cppargparse/tokenizer.h>
+
+
+namespace cppargparse {
+namespace parser {
+
+
+template <size_t MaxOptions, size_t MaxTokens>
+/**
+ * @brief The fixed-capacity argument parser class.
+ *
+ * Meant for targets where heap allocations are forbidden after initialization:
+ *  - the lexed command line and the registered arguments live in storage inside the parser object
+ *  - the command line characters are not copied: argv or the command string buffer must outlive the parsed values
+ *  - values are written into caller provided storage
+ *  - capacity overflows and conversion failures are reported as #cppargparse::errors::ErrorCode
+ *
+ * Registering an argument copies its IDs and description, which may allocate for long strings,
+ * so arguments should be registered during initialization. Command lines are lexed against the
+ * arguments registered when parse() is called, see #cppargparse::lexer::option_length().
+ * The argument<T> converters are shared with #cppargparse::parser::ArgumentParser.
+ *
+ * @tparam MaxOptions The maximum number of registered arguments.
+ * @tparam MaxTokens The maximum number of lexed command line tokens.
+ */
+class StaticArgumentParser
+{
+public:
+    /**
+     * @brief c'tor
+     */
+    StaticArgumentParser()
+        : m_storage()
+        , m_resource(m_storage.data(), m_storage.size(), std::pmr::null_memory_resource())
+        , m_cmd(&m_resource)
+        , m_cmdargs(&m_resource)
+    {
+        m_cmd.reserve(MaxTokens);
+        m_cmdargs.reserve(MaxOptions);
+    }
+
+
+    StaticArgumentParser(const StaticArgumentParser &) = delete;
+    StaticArgumentParser &operator=(const StaticArgumentParser &) = delete;
+
+
+    /**
+     * @brief Add an argument to the command line arguments list.
+     *
+     * @param id The argument ID.
+     * @param id_alt The alternative argument ID.
+     * @param description The argument description.
+     *
+     * @return The registered command line argument, valid for the lifetime of the parser,
+     *         or nullptr if MaxOptions arguments have been registered already.
+     */
+    const cmd::CommandLineArgument *add_arg(const std::string &id, const std::string &id_alt = std::string(),
+                                            const std::string &description = std::string())
+    {
+        if (m_cmdargs.size() == MaxOptions)
+        {
+            return nullptr;
+        }
+
+        m_cmdargs.emplace_back(id, id_alt, description, m_cmd.cend());
+        m_cmdargs.back().m_index = m_cmdargs.size() - 1;
+
+        reposition(m_cmdargs.back());
+        return &m_cmdargs.back();
+    }
+
+
+    /**
+     * @brief Parse a command line. The previous command line is discarded.
+     *
+     * @param argc The command line argument count.
+     * @param argv The command line argument array. Must outlive the parsed values.
+     *
+     * @return #cppargparse::errors::ErrorCode::CapacityExceeded if the command line has more than MaxTokens tokens.
+     */
+    errors::ErrorCode parse(int argc, char *argv[])
+    {
+        m_cmd.clear();
+        lexer::Lexer lexer(m_cmd, m_cmdargs);
+
+        for (int i = 0; i < argc; ++i)
+        {
+            const std::string_view token(argv[i]);
+
+            if (m_cmd.size() + lexer.count(token) > MaxTokens)
+            {
+                return fail(errors::ErrorCode::CapacityExceeded);
+            }
+
+            lexer.lex(token);
+        }
+
+        return reposition();
+    }
+
+
+    /**
+     * @brief Parse a command string. The previous command line is discarded.
+     *
+     * See #cppargparse::tokenizer::tokenize() for the quoting rules.
+     *
+     * @param first The first character of the command string. Unquoted in place, must outlive the parsed values.
+     * @param last The end of the command string.
+     *
+     * @return #cppargparse::errors::ErrorCode::CapacityExceeded if the command string has more than MaxTokens tokens,
+     *         #cppargparse::errors::ErrorCode::SyntaxError if a quote is not closed.
+     */
+    errors::ErrorCode parse(char *first, char *last)
+    {
+        m_cmd.clear();
+        lexer::Lexer lexer(m_cmd, m_cmdargs);
+        bool exceeded = false;
+
+        const auto error = errors::capture([&]()
+        {
+            tokenizer::tokenize(first, last, [&](const std::string_view &token)
+            {
+                exceeded = exceeded || m_cmd.size() + lexer.count(token) > MaxTokens;
+
+                if (!exceeded)
+                {
+                    lexer.lex(token);
+                }
+            });
+        });
+
+        if (error != errors::ErrorCode::None)
+        {
+            return fail(error);
+        }
+
+        return exceeded ? fail(errors::ErrorCode::CapacityExceeded) : reposition();
+    }
+
+
+    /**
+     * @brief Return whether the command line contains an argument.
+     *
+     * @param cmdarg The registered command line argument.
+     *
+     * @return Whether the command line contains the argument.
+     */
+    bool get_flag(const cmd::CommandLineArgument &cmdarg) const
+    {
+        return cmdarg.position() != m_cmd.cend();
+    }
+
+
+    /**
+     * @brief Return how often an argument has been passed to the command line.
+     *
+     * @param cmdarg The registered command line argument.
+     *
+     * @return The number of occurrences of the argument before the "--" terminator.
+     */
+    size_t count(const cmd::CommandLineArgument &cmdarg) const
+    {
+        size_t occurrences = 0;
+
+        for (auto it = cmdarg.position(); it != m_cmd.cend() && *it != lexer::terminator; ++it)
+        {
+            if (cmd::is_arg_id(*it, cmdarg.id(), cmdarg.id_alt()))
+            {
+                ++occurrences;
+            }
+        }
+
+        return occurrences;
+    }
+
+
+    template <typename T>
+    /**
+     * @brief Convert the argument value.
+     *
+     * @tparam T The argument type. argument::parse() and argument::convert() must be implemented for T.
+     *
+     * @param cmdarg The registered command line argument.
+     * @param value The value to write the converted argument value to. Left untouched on errors.
+     *
+     * @return #cppargparse::errors::ErrorCode::ArgumentNotFound if the argument cannot be found,
+     *         #cppargparse::errors::ErrorCode::InvalidValue if the value cannot be converted.
+     */
+    errors::ErrorCode get_option(const cmd::CommandLineArgument &cmdarg, T &value) const
+    {
+        if (cmdarg.position() == m_cmd.cend())
+        {
+            return errors::ErrorCode::ArgumentNotFound;
+        }
+
+        // Without exceptions, a failed conversion still returns a value
+        T converted {};
+
+        const auto error = errors::capture([&]()
+        {
+            converted = argument<T>::parse(m_cmd, cmdarg.position(), m_cmdargs);
+        });
+
+        if (error == errors::ErrorCode::None)
+        {
+            value = converted;
+        }
+
+        return error;
+    }
+
+
+    template <typename T>
+    /**
+     * @brief Convert the values of an argument followed by a sequence of values into caller provided storage.
+     *
+     * Tokens holding several values separated by list_delimiter<T> count as several values.
+     *
+     * @tparam T The value type. argument::convert() must be implemented for T.
+     *
+     * @param cmdarg The registered command line argument.
+     * @param values The storage to write the converted values to.
+     * @param capacity The number of values the storage can hold.
+     * @param size The number of converted values.
+     *
+     * @return #cppargparse::errors::ErrorCode::ArgumentNotFound if the argument cannot be found,
+     *         #cppargparse::errors::ErrorCode::CapacityExceeded if there are more than capacity values,
+     *         #cppargparse::errors::ErrorCode::InvalidValue if a value cannot be converted.
+     */
+    errors::ErrorCode get_option(const cmd::CommandLineArgument &cmdarg, T *values, size_t capacity, size_t &size) const
+    {
+        size = 0;
+
+        if (cmdarg.position() == m_cmd.cend())
+        {
+            return errors::ErrorCode::ArgumentNotFound;
+        }
+
+        const auto end = algorithm::find_option_end(m_cmd, cmdarg.position(), m_cmdargs);
+
+        if (common::count_values<T>(std::next(cmdarg.position()), end) > capacity)
+        {
+            return errors::ErrorCode::CapacityExceeded;
+        }
+
+        errors::ErrorCode error = errors::ErrorCode::None;
+
+        for (auto position = std::next(cmdarg.position()); position != end && error == errors::ErrorCode::None; ++position)
+        {
+            split::for_each(*position, list_delimiter<T>::value, [&](const std::string_view &value)
+            {
+                if (error == errors::ErrorCode::None)
+                {
+                    error = errors::capture([&]()
+                    {
+                        values[size] = common::convert_value<T>(m_cmd, position, value, m_cmdargs);
+                    });
+
+                    size += (error == errors::ErrorCode::None) ? 1 : 0;
+                }
+            });
+        }
+
+        return error;
+    }
+
+
+    template <typename T, size_t N>
+    /**
+     * @brief Convert the values of an argument followed by a sequence of values into a std::array.
+     *
+     * @tparam T The value type. argument::convert() must be implemented for T.
+     * @tparam N The array size.
+     *
+     * @param cmdarg The registered command line argument.
+     * @param values The array to write the converted values to.
+     * @param size The number of converted values.
+     *
+     * @return See get_option(const cmd::CommandLineArgument &, T *, size_t, size_t &).
+     */
+    errors::ErrorCode get_option(const cmd::CommandLineArgument &cmdarg, std::array<T, N> &values, size_t &size) const
+    {
+        return get_option(cmdarg, values.data(), N, size);
+    }
+
+
+private:
+    /**
+     * @brief Discard the current command line after an error.
+     *
+     * @param error The error code to report.
+     *
+     * @return The error code.
+     */
+    errors::ErrorCode fail(const errors::ErrorCode error)
+    {
+        m_cmd.clear();
+        reposition();
+
+        return error;
+    }
+
+
+    /**
+     * @brief Resolve all registered argument positions against the current command line.
+     *
+     * @return #cppargparse::errors::ErrorCode::None
+     */
+    errors::ErrorCode reposition()
+    {
+        for (auto &cmdarg : m_cmdargs)
+        {
+            reposition(cmdarg);
+        }
+
+        return errors::ErrorCode::None;
+    }
+
+
+    /**
+     * @brief Resolve the first position of a registered argument against the current command line.
+     *
+     * @param cmdarg The registered command line argument.
+     */
+    void reposition(cmd::CommandLineArgument &cmdarg)
+    {
+        cmdarg.m_position = algorithm::find_arg_position(m_cmd, cmdarg.id(), cmdarg.id_alt());
+    }
+
+
+    /// The storage for the command line tokens and the registered arguments
+    alignas(std::max_align_t) std::array<std::byte, MaxTokens * sizeof(std::string_view) + MaxOptions * sizeof(cmd::CommandLineArgument) + alignof(std::max_align_t)> m_storage;
+
+    /// The memory resource handing out m_storage, never falls back to the heap
+    std::pmr::monotonic_buffer_resource m_resource;
+
+    /// The command line
+    cmd::CommandLine_t m_cmd;
+
+    /// The command line arguments
+    cmd::CommandLineArguments_t m_cmdargs;
+};
+
+
+} // namespace parser
+} // namespace cppargparse
+
+#endif // CPPARGPARSE_STATIC_PARSER_H
@@ -0,0 +1,65 @@
+#ifndef CPPARGPARSE_TERMINAL_H
+#define CPPARGPARSE_TERMINAL_H
+
+/**
+  @file cppargparse/terminal.h
+  @brief Terminal width detection for laying out the usage string.
+ */
+
+
+#include <cstddef>
+#include <cstdlib>
+
+#if !defined(_WIN32)
+#include <sys/ioctl.h>
+#include <unistd.h>
+#endif
+
+
+namespace cppargparse {
+namespace terminal {
+
+
+/**
+ * @brief Return the width of the terminal a file descriptor refers to.
+ *
+ * Asks the terminal driver first and falls back to the COLUMNS environment variable.
+ *
+ * @param fd The file descriptor, e.g. STDOUT_FILENO.
+ *
+ * @return The number of terminal columns or 0 if the file descriptor doesn't refer to a terminal.
+ */
+inline size_t width(int fd)
+{
+#if defined(_WIN32)
+    (void) fd;
+#else
+    if (!::isatty(fd))
+    {
+        return 0;
+    }
+
+    winsize size {};
+
+    if (::ioctl(fd, TIOCGWINSZ, &size) == 0 && size.ws_col > 0)
+    {
+        return size.ws_col;
+    }
+#endif
+
+    const char *columns = std::getenv("COLUMNS");
+
+    if (columns == nullptr)
+    {
+        return 0;
+    }
+
+    const long value = std::strtol(columns, nullptr, 10);
+    return (value > 0) ? static_cast<size_t>(value) : 0;
+}
+
+
+} // namespace terminal
+} // namespace cppargparse
+
+#endif // CPPARGPARSE_TERMINAL_H
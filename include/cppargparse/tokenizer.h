@@ -0,0 +1,303 @@
+#ifndef CPPARGPARSE_TOKENIZER_H
+#define CPPARGPARSE_TOKENIZER_H
+
+/**
+  @file cppargparse/tokenizer.h
+  @brief Shell-style tokenizer splitting a command string into command line tokens.
+ */
+
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "errors.h"
+
+
+namespace cppargparse {
+namespace tokenizer {
+
+
+/**
+ * @brief Build the lookup table of characters the tokenizer has to stop at.
+ *
+ * @return The lookup table: blanks, quotes and the backslash are marked.
+ */
+constexpr std::array<bool, 256> make_special_characters()
+{
+    std::array<bool, 256> special {};
+
+    for (const char c : {' ', '\t', '\n', '\r', '\'', '"', '\\'})
+    {
+        special[static_cast<unsigned char>(c)] = true;
+    }
+
+    return special;
+}
+
+
+/// The lookup table of characters the tokenizer has to stop at.
+static constexpr std::array<bool, 256> special_characters = make_special_characters();
+
+
+/**
+ * @brief Return whether a character separates tokens.
+ *
+ * @param c The character.
+ *
+ * @return Whether the character is a space, tab, newline or carriage return.
+ */
+constexpr bool is_blank(const char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+
+/**
+ * @brief Return whether a backslash escapes a character inside double quotes.
+ *
+ * @param c The character following the backslash.
+ *
+ * @return Whether the character is $, `, ", \ or a newline.
+ */
+constexpr bool is_double_quote_escape(const char c)
+{
+    return c == '$' || c == '`' || c == '"' || c == '\\' || c == '\n';
+}
+
+
+/**
+ * @brief Find the next blank, quote or backslash.
+ *
+ * Scans 16 characters at a time if SSE2 is available.
+ *
+ * @param first The first character to scan.
+ * @param last The end of the characters to scan.
+ *
+ * @return The position of the next special character or last if there is none.
+ */
+inline const char *find_special(const char *first, const char *last)
+{
+#if defined(__SSE2__)
+    const __m128i space = _mm_set1_epi8(' ');
+    const __m128i tab = _mm_set1_epi8('\t');
+    const __m128i newline = _mm_set1_epi8('\n');
+    const __m128i carriage_return = _mm_set1_epi8('\r');
+    const __m128i single_quote = _mm_set1_epi8('\'');
+    const __m128i double_quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+
+    for (; last - first >= 16; first += 16)
+    {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(first));
+
+        const __m128i blanks = _mm_or_si128(
+                    _mm_or_si128(_mm_cmpeq_epi8(chunk, space), _mm_cmpeq_epi8(chunk, tab)),
+                    _mm_or_si128(_mm_cmpeq_epi8(chunk, newline), _mm_cmpeq_epi8(chunk, carriage_return)));
+
+        const __m128i escapes = _mm_or_si128(
+                    _mm_or_si128(_mm_cmpeq_epi8(chunk, single_quote), _mm_cmpeq_epi8(chunk, double_quote)),
+                    _mm_cmpeq_epi8(chunk, backslash));
+
+        const int mask = _mm_movemask_epi8(_mm_or_si128(blanks, escapes));
+
+        if (mask != 0)
+        {
+            return first + __builtin_ctz(static_cast<unsigned int>(mask));
+        }
+    }
+#endif
+
+    while (first != last && !special_characters[static_cast<unsigned char>(*first)])
+    {
+        ++first;
+    }
+
+    return first;
+}
+
+
+/**
+ * @brief Report an unclosed quote.
+ *
+ * @param quote The quote character.
+ * @param text The unquoted text following the quote.
+ * @param token The index of the token containing the quote.
+ *
+ * @return #cppargparse::errors::ErrorCode::SyntaxError
+ * @throws #cppargparse::errors::CommandLineSyntaxError
+ */
+inline errors::ErrorCode unterminated_quote(const char quote, const std::string_view &text, size_t token)
+{
+    std::array<char, sizeof(errors::ErrorPayload::subject)> subject;
+    const size_t length = std::min(text.size(), subject.size() - 1);
+
+    subject[0] = quote;
+    std::memcpy(subject.data() + 1, text.data(), length);
+
+    errors::raise<errors::CommandLineSyntaxError>(errors::make_payload(
+                errors::ErrorCode::SyntaxError, token, errors::no_index, nullptr, std::string_view(subject.data(), length + 1)));
+
+    return errors::ErrorCode::SyntaxError;
+}
+
+
+template <typename Callback>
+/**
+ * @brief Split a command string into tokens following POSIX shell quoting rules.
+ *
+ * The buffer is unquoted in place, so every token is a view into it:
+ *  - blanks separate tokens unless quoted or escaped
+ *  - a backslash outside of quotes preserves the next character, backslash-newline is removed
+ *  - single quotes preserve every character up to the closing quote
+ *  - double quotes preserve every character except backslash-escaped $, `, ", \ and newline
+ *  - quoted and unquoted parts of a word are joined, "" yields an empty token
+ *
+ * @tparam Callback The token callback type, called as callback(std::string_view).
+ *
+ * @param first The first character of the command string. The characters are rewritten.
+ * @param last The end of the command string.
+ * @param callback The callback to call with every token, in command string order.
+ *
+ * @return #cppargparse::errors::ErrorCode::SyntaxError if a quote is not closed, the remaining characters are dropped.
+ * @throws #cppargparse::errors::CommandLineSyntaxError if a quote is not closed.
+ */
+errors::ErrorCode tokenize(char *first, char *last, Callback &&callback)
+{
+    const char *read = first;
+    char *write = first;
+    size_t count = 0;
+
+    // Move characters to the write position; they only ever move towards the front
+    const auto copy = [&](const char *from, const char *to)
+    {
+        if (write != from)
+        {
+            std::memmove(write, from, static_cast<size_t>(to - from));
+        }
+
+        write += to - from;
+    };
+
+    while (true)
+    {
+        while (read != last && is_blank(*read))
+        {
+            ++read;
+        }
+
+        if (read == last)
+        {
+            break;
+        }
+
+        char *token = write;
+
+        while (read != last)
+        {
+            const char *special = find_special(read, last);
+            copy(read, special);
+            read = special;
+
+            if (read == last || is_blank(*read))
+            {
+                break;
+            }
+
+            if (*read == '\\')
+            {
+                ++read;
+
+                if (read == last)
+                {
+                    // A trailing backslash stands for itself
+                    *write++ = '\\';
+                }
+                else if (*read++ != '\n')
+                {
+                    *write++ = read[-1];
+                }
+            }
+            else if (*read == '\'')
+            {
+                const char *closing = static_cast<const char *>(std::memchr(read + 1, '\'', static_cast<size_t>(last - read - 1)));
+
+                if (closing == nullptr)
+                {
+                    return unterminated_quote('\'', std::string_view(read + 1, static_cast<size_t>(last - read - 1)), count);
+                }
+
+                copy(read + 1, closing);
+                read = closing + 1;
+            }
+            else
+            {
+                const char *quoted = write;
+
+                for (++read; ; ++read)
+                {
+                    if (read == last)
+                    {
+                        // The quoted characters have been moved to the front already
+                        return unterminated_quote('"', std::string_view(quoted, static_cast<size_t>(write - quoted)), count);
+                    }
+
+                    if (*read == '"')
+                    {
+                        ++read;
+                        break;
+                    }
+
+                    if (*read == '\\' && read + 1 != last && is_double_quote_escape(read[1]))
+                    {
+                        if (*++read == '\n')
+                        {
+                            continue;
+                        }
+                    }
+
+                    *write++ = *read;
+                }
+            }
+        }
+
+        callback(std::string_view(token, static_cast<size_t>(write - token)));
+        ++count;
+    }
+
+    return errors::ErrorCode::None;
+}
+
+
+/**
+ * @brief Split a command string into tokens following POSIX shell quoting rules.
+ *
+ * @param buffer The command string. Unquoted in place, the tokens view into it.
+ *
+ * @return The tokens, in command string order.
+ * @throws #cppargparse::errors::CommandLineSyntaxError if a quote is not closed.
+ */
+inline std::vector<std::string_view> tokenize(std::string &buffer)
+{
+    std::vector<std::string_view> tokens;
+
+    tokenize(buffer.data(), buffer.data() + buffer.size(), [&](const std::string_view &token)
+    {
+        tokens.emplace_back(token);
+    });
+
+    return tokens;
+}
+
+
+} // namespace tokenizer
+} // namespace cppargparse
+
+#endif // CPPARGPARSE_TOKENIZER_H
@@ -0,0 +1,270 @@
+#ifndef CPPARGPARSE_UTF8_H
+#define CPPARGPARSE_UTF8_H
+
+/**
+  @file cppargparse/utf8.h
+  @brief UTF-8 display width computation for laying out the usage string.
+ */
+
+
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+
+namespace cppargparse {
+namespace utf8 {
+
+
+/**
+ * @brief A range of code points sharing the same display width.
+ */
+struct CodePointRange
+{
+    /// The first code point of the range.
+    char32_t first;
+
+    /// The last code point of the range.
+    char32_t last;
+};
+
+
+/// Combining marks and zero-width characters, which don't occupy a terminal column.
+static constexpr CodePointRange zero_width_ranges[] = {
+    {0x0300, 0x036F}, {0x0483, 0x0489}, {0x0591, 0x05BD}, {0x0610, 0x061A}, {0x064B, 0x065F},
+    {0x0E31, 0x0E31}, {0x0E34, 0x0E3A}, {0x0E47, 0x0E4E}, {0x1AB0, 0x1AFF}, {0x1DC0, 0x1DFF},
+    {0x200B, 0x200F}, {0x202A, 0x202E}, {0x2060, 0x2064}, {0x20D0, 0x20FF}, {0xFE00, 0xFE0F},
+    {0xFE20, 0xFE2F}, {0xFEFF, 0xFEFF}, {0xE0100, 0xE01EF}
+};
+
+
+/// East Asian wide and fullwidth characters and emoji, which occupy two terminal columns.
+static constexpr CodePointRange wide_ranges[] = {
+    {0x1100, 0x115F}, {0x231A, 0x231B}, {0x2329, 0x232A}, {0x23E9, 0x23EC}, {0x25FD, 0x25FE},
+    {0x2614, 0x2615}, {0x2648, 0x2653}, {0x26AA, 0x26AB}, {0x26BD, 0x26BE}, {0x26F5, 0x26F5},
+    {0x2705, 0x2705}, {0x274C, 0x274C}, {0x2795, 0x2797}, {0x2B1B, 0x2B1C}, {0x2E80, 0x303E},
+    {0x3041, 0x33FF}, {0x3400, 0x4DBF}, {0x4E00, 0x9FFF}, {0xA000, 0xA4CF}, {0xA960, 0xA97F},
+    {0xAC00, 0xD7A3}, {0xF900, 0xFAFF}, {0xFE10, 0xFE19}, {0xFE30, 0xFE6F}, {0xFF00, 0xFF60},
+    {0xFFE0, 0xFFE6}, {0x16FE0, 0x18AFF}, {0x1B000, 0x1B2FF}, {0x1F004, 0x1F004}, {0x1F0CF, 0x1F0CF},
+    {0x1F18E, 0x1F18E}, {0x1F191, 0x1F19A}, {0x1F200, 0x1F251}, {0x1F300, 0x1F64F}, {0x1F680, 0x1F6FF},
+    {0x1F7E0, 0x1F7EB}, {0x1F90C, 0x1F9FF}, {0x1FA70, 0x1FAFF}, {0x20000, 0x2FFFD}, {0x30000, 0x3FFFD}
+};
+
+
+template <size_t N>
+/**
+ * @brief Return whether a code point is inside one of the sorted code point ranges.
+ *
+ * @tparam N The number of ranges.
+ *
+ * @param ranges The sorted, non-overlapping code point ranges.
+ * @param code_point The code point.
+ *
+ * @return Whether the code point is inside one of the ranges.
+ */
+constexpr bool contains(const CodePointRange (&ranges)[N], const char32_t code_point)
+{
+    size_t low = 0;
+    size_t high = N;
+
+    while (low < high)
+    {
+        const size_t middle = (low + high) / 2;
+
+        if (code_point < ranges[middle].first)
+        {
+            high = middle;
+        }
+        else if (code_point > ranges[middle].last)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+/**
+ * @brief Return the number of terminal columns a code point occupies.
+ *
+ * @param code_point The code point.
+ *
+ * @return 0 for combining marks and zero-width characters, 2 for wide characters, 1 otherwise.
+ */
+constexpr size_t code_point_width(const char32_t code_point)
+{
+    if (code_point < 0x0300)
+    {
+        return 1;
+    }
+
+    if (contains(zero_width_ranges, code_point))
+    {
+        return 0;
+    }
+
+    return contains(wide_ranges, code_point) ? 2 : 1;
+}
+
+
+/**
+ * @brief Return the number of leading ASCII characters.
+ *
+ * Checks 16 characters at a time if SSE2 is available and 8 characters at a time otherwise.
+ *
+ * @param text The text.
+ *
+ * @return The length of the text's ASCII prefix.
+ */
+inline size_t ascii_prefix(const std::string_view &text)
+{
+    const char *first = text.data();
+    const char *last = text.data() + text.size();
+    const char *current = first;
+
+#if defined(__SSE2__)
+    for (; last - current >= 16; current += 16)
+    {
+        // The sign bit of every byte is set for non-ASCII characters only
+        const int mask = _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(current)));
+
+        if (mask != 0)
+        {
+            return static_cast<size_t>(current - first) + static_cast<size_t>(__builtin_ctz(static_cast<unsigned int>(mask)));
+        }
+    }
+#endif
+
+    for (; last - current >= 8; current += 8)
+    {
+        uint64_t chunk;
+        std::memcpy(&chunk, current, sizeof(chunk));
+
+        if ((chunk & 0x8080808080808080ull) != 0)
+        {
+            break;
+        }
+    }
+
+    while (current != last && static_cast<unsigned char>(*current) < 0x80)
+    {
+        ++current;
+    }
+
+    return static_cast<size_t>(current - first);
+}
+
+
+/**
+ * @brief Decode the code point at the start of a non-empty text.
+ *
+ * Invalid or truncated sequences decode to the replacement character U+FFFD and consume one byte.
+ *
+ * @param text The text.
+ * @param length The length of the decoded UTF-8 sequence.
+ *
+ * @return The decoded code point.
+ */
+constexpr char32_t decode(const std::string_view &text, size_t &length)
+{
+    const auto byte = [&](const size_t i)
+    {
+        return static_cast<unsigned char>(text[i]);
+    };
+
+    const unsigned char lead = byte(0);
+    length = (lead < 0x80) ? 1 : (lead >> 5) == 0x6 ? 2 : (lead >> 4) == 0xE ? 3 : (lead >> 3) == 0x1E ? 4 : 0;
+
+    if (length == 0 || length > text.size())
+    {
+        length = 1;
+        return 0xFFFD;
+    }
+
+    char32_t code_point = (length == 1) ? lead : lead & (0x7F >> length);
+
+    for (size_t i = 1; i < length; ++i)
+    {
+        if ((byte(i) & 0xC0) != 0x80)
+        {
+            length = 1;
+            return 0xFFFD;
+        }
+
+        code_point = (code_point << 6) | (byte(i) & 0x3F);
+    }
+
+    return code_point;
+}
+
+
+/**
+ * @brief Return the number of terminal columns a UTF-8 text occupies, one code point at a time.
+ *
+ * Usable in constant expressions.
+ *
+ * @param text The UTF-8 text.
+ *
+ * @return The display width of the text.
+ */
+constexpr size_t display_width_scalar(std::string_view text)
+{
+    size_t width = 0;
+
+    while (!text.empty())
+    {
+        size_t length = 0;
+        width += code_point_width(decode(text, length));
+        text.remove_prefix(length);
+    }
+
+    return width;
+}
+
+
+/**
+ * @brief Return the number of terminal columns a UTF-8 text occupies.
+ *
+ * ASCII runs are counted in bulk, see ascii_prefix().
+ *
+ * @param text The UTF-8 text.
+ *
+ * @return The display width of the text.
+ */
+inline size_t display_width(std::string_view text)
+{
+    size_t width = 0;
+
+    while (!text.empty())
+    {
+        const size_t ascii = ascii_prefix(text);
+        width += ascii;
+        text.remove_prefix(ascii);
+
+        if (text.empty())
+        {
+            break;
+        }
+
+        size_t length = 0;
+        width += code_point_width(decode(text, length));
+        text.remove_prefix(length);
+    }
+
+    return width;
+}
+
+
+} // namespace utf8
+} // namespace cppargparse
+
+#endif // CPPARGPARSE_UTF8_H
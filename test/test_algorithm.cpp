@@ -147,6 +147,78 @@ TEST(TestAlgorithm, FindArgPositionByInvalidID)
 }
 
 
+//
+// find_arg_positions(<cmd: -I a -t 3 --include b -I c>)
+//
+TEST(TestAlgorithm, FindArgPositions)
+{
+    using namespace cppargparse;
+
+    const cmd::CommandLine_t cmd {
+        "-I", "a", "-t", "3", "--include", "b", "-I", "c"
+    };
+
+
+    const cmd::CommandLinePositions_t positions = algorithm::find_arg_positions(cmd, "-I", "--include");
+
+    const cmd::CommandLinePositions_t expected = {
+        cmd.cbegin(),
+        cmd.cbegin() + 4,
+        cmd.cbegin() + 6
+    };
+
+    ASSERT_EQ(expected, positions);
+    ASSERT_TRUE(algorithm::find_arg_positions(cmd, "-y", "--yes").empty());
+}
+
+
+//
+// find_arg_positions(<cmd: -v "" -v "">)
+//
+TEST(TestAlgorithm, FindArgPositionsEmptyToken)
+{
+    using namespace cppargparse;
+
+    const cmd::CommandLine_t cmd {
+        "-v", "", "-v", ""
+    };
+
+    // An unset alternative ID doesn't match empty tokens
+    const cmd::CommandLinePositions_t expected = {
+        cmd.cbegin(),
+        cmd.cbegin() + 2
+    };
+
+    ASSERT_EQ(expected, algorithm::find_arg_positions(cmd, "-v", ""));
+    ASSERT_EQ(cmd.cend(), algorithm::find_arg_position(cmd, "-x", ""));
+}
+
+
+//
+// find_negatable_arg_positions(<cmd: --cache --no-cache -c --no-c --no-cache>)
+//
+TEST(TestAlgorithm, FindNegatableArgPositions)
+{
+    using namespace cppargparse;
+
+    const cmd::CommandLine_t cmd {
+        "--cache", "--no-cache", "-c", "--no-c", "--no-cached", "--no-cache"
+    };
+
+    cmd::CommandLinePositions_t positions;
+    algorithm::find_negatable_arg_positions(cmd, "-c", "--cache", positions);
+
+    const cmd::CommandLinePositions_t expected = {
+        cmd.cbegin(),
+        cmd.cbegin() + 1,
+        cmd.cbegin() + 2,
+        cmd.cbegin() + 5
+    };
+
+    ASSERT_EQ(expected, positions);
+}
+
+
 //
 // get_option_positions(<cmd: -t 3 6 20 -f 5>)
 //
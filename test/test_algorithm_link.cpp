@@ -0,0 +1,19 @@
+#include <gtest/gtest.h>
+
+#include <cppargparse/cppargparse.h>
+
+#include "test_common.h"
+
+
+//
+// Second translation unit of test_algorithm: the library is header-only,
+// so including it from several sources of one program must link.
+//
+TEST(TestAlgorithm, SecondTranslationUnit)
+{
+    using namespace cppargparse;
+    auto arg_parser = test::make_arg_parser(test::parse_cmdargs("-t 3 -t 4"), "TestAlgorithm");
+
+    const auto time = arg_parser.add_arg("-t");
+    ASSERT_EQ(size_t(2), arg_parser.count(time));
+}
@@ -1,7 +1,20 @@
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <deque>
+#include <filesystem>
+#include <fstream>
 #include <functional>
 #include <limits>
 #include <list>
+#include <memory_resource>
+#include <optional>
+#include <set>
 #include <sstream>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include <gtest/gtest.h>
@@ -48,6 +61,26 @@ void assert_eq_wrap<float>(const float &v1, const float &v2)
 // - Helper functions
 // -------------------------
 
+template <typename T>
+const T &printable(const T &value)
+{
+    return value;
+}
+
+
+// Signed and unsigned char are 8-bit integers, print them as numbers rather than characters
+inline int printable(const signed char &value)
+{
+    return value;
+}
+
+
+inline unsigned int printable(const unsigned char &value)
+{
+    return value;
+}
+
+
 template <typename T>
 void value_test(const T &value, const T &default_value)
 {
@@ -55,7 +88,7 @@ void value_test(const T &value, const T &default_value)
 
     // Generate a command line argument string with "-t <value>"
     std::ostringstream cmd;
-    cmd << "-t " << std::fixed << std::setprecision(15) << value;
+    cmd << "-t " << std::fixed << std::setprecision(15) << printable(value);
 
 
     // Expect the same number as <value> when parsing the command line string for "-t"
@@ -80,7 +113,7 @@ void max_test(const bool out_of_range)
 
     // Generate a command line argument string with <max>
     std::ostringstream cmd;
-    cmd << "-t " << std::fixed << std::setprecision(30) << max;
+    cmd << "-t " << std::fixed << std::setprecision(30) << printable(max);
 
     // If we're testing for out of range, add a 0 to <cmd>
     if (out_of_range)
@@ -96,7 +129,7 @@ void max_test(const bool out_of_range)
     // If we're testing for out of range, expect an error...
     if (out_of_range)
     {
-        ASSERT_THROW(arg_parser.get_option<T>(t), errors::CommandLineOptionError);
+        ASSERT_ERROR(arg_parser.get_option<T>(t), errors::CommandLineOptionError);
     }
     else
     {
@@ -118,7 +151,7 @@ void vector_test(const std::vector<T> &seq_expected, const bool reach_end, const
 
     for (const auto &seq_value : seq_expected)
     {
-        cmd << ' ' << std::fixed << std::setprecision(15) << seq_value;
+        cmd << ' ' << std::fixed << std::setprecision(15) << printable(seq_value);
     }
 
 
@@ -141,7 +174,7 @@ void vector_test(const std::vector<T> &seq_expected, const bool reach_end, const
         if (reach_end_should_throw)
         {
             // ... should throw an error
-            ASSERT_THROW(arg_parser.get_option<std::vector<T>>(seq), errors::CommandLineOptionError);
+            ASSERT_ERROR(arg_parser.get_option<std::vector<T>>(seq), errors::CommandLineOptionError);
         }
 
         // ... so, add the next argument to the parser
@@ -171,7 +204,7 @@ void list_test(const std::vector<T> &seq_expected, const bool reach_end, const b
 
     for (const auto &seq_value : seq_expected)
     {
-        cmd << ' ' << std::fixed << std::setprecision(15) << seq_value;
+        cmd << ' ' << std::fixed << std::setprecision(15) << printable(seq_value);
     }
 
 
@@ -194,7 +227,7 @@ void list_test(const std::vector<T> &seq_expected, const bool reach_end, const b
         if (reach_end_should_throw)
         {
             // ... should throw an error
-            ASSERT_THROW(arg_parser.get_option<std::list<T>>(seq), errors::CommandLineOptionError);
+            ASSERT_ERROR(arg_parser.get_option<std::list<T>>(seq), errors::CommandLineOptionError);
         }
 
         // ... so, add the next argument to the parser
@@ -298,6 +331,7 @@ TEST(TestArguments, Int8)
 TEST(TestArguments, Int8Max)
 {
     max_test<int8_t>(false);
+    max_test<int8_t>(true);
 }
 
 TEST(TestArguments, Int8Vector)
@@ -332,6 +366,17 @@ TEST(TestArguments, UInt8)
 TEST(TestArguments, UInt8Max)
 {
     max_test<uint8_t>(false);
+    max_test<uint8_t>(true);
+}
+
+TEST(TestArguments, UInt8Number)
+{
+    using namespace cppargparse;
+    parser::ArgumentParser arg_parser("--level 200 --char 200", "TestArguments");
+
+    // 8-bit integers read numbers, plain char takes the first character
+    ASSERT_EQ(uint8_t(200), arg_parser.get_option<uint8_t>(arg_parser.add_arg("--level")));
+    ASSERT_EQ('2', arg_parser.get_option<char>(arg_parser.add_arg("--char")));
 }
 
 TEST(TestArguments, UInt8Vector)
@@ -800,6 +845,1070 @@ TEST(TestArguments, UnsignedLongLongListReachEnd)
 }
 
 
+//
+// parse_integer()
+//
+template <typename T>
+bool parses_to(const std::string &s, const T expected)
+{
+    T value {};
+    return cppargparse::parse_integer<T>(s, value) && value == expected;
+}
+
+
+template <typename T>
+bool rejects(const std::string &s)
+{
+    T value {};
+    return !cppargparse::parse_integer<T>(s, value);
+}
+
+
+TEST(TestArguments, IntegerBasePrefixes)
+{
+    ASSERT_TRUE(parses_to<int>("0x7f", 127));
+    ASSERT_TRUE(parses_to<int>("0XFF", 255));
+    ASSERT_TRUE(parses_to<int>("-0o17", -15));
+    ASSERT_TRUE(parses_to<int>("+0b1010", 10));
+    ASSERT_TRUE(parses_to<int>("0", 0));
+    ASSERT_TRUE(parses_to<int>("010", 10));
+
+    ASSERT_TRUE(rejects<int>("0x"));
+    ASSERT_TRUE(rejects<int>("0b102"));
+    ASSERT_TRUE(rejects<int>("0o8"));
+}
+
+
+TEST(TestArguments, IntegerSeparators)
+{
+    ASSERT_TRUE(parses_to<int>("1_000_000", 1000000));
+    ASSERT_TRUE(parses_to<uint32_t>("0xdead_beef", 0xdeadbeefu));
+
+    ASSERT_TRUE(rejects<int>("_1"));
+    ASSERT_TRUE(rejects<int>("1_"));
+    ASSERT_TRUE(rejects<int>("1__0"));
+    ASSERT_TRUE(rejects<int>("0x_1"));
+}
+
+
+TEST(TestArguments, IntegerExactRange)
+{
+    ASSERT_TRUE(parses_to<uint8_t>("200", 200));
+    ASSERT_TRUE(parses_to<int8_t>("-128", -128));
+    ASSERT_TRUE(rejects<int8_t>("128"));
+    ASSERT_TRUE(rejects<uint8_t>("256"));
+    ASSERT_TRUE(rejects<uint8_t>("a"));
+
+    ASSERT_TRUE(parses_to<int16_t>("32767", 32767));
+    ASSERT_TRUE(parses_to<int16_t>("-32768", -32768));
+    ASSERT_TRUE(rejects<int16_t>("32768"));
+    ASSERT_TRUE(rejects<int16_t>("-32769"));
+    ASSERT_TRUE(rejects<uint16_t>("65536"));
+    ASSERT_TRUE(rejects<uint16_t>("-1"));
+
+    ASSERT_TRUE(parses_to<int64_t>("-9223372036854775808", std::numeric_limits<int64_t>::min()));
+    ASSERT_TRUE(rejects<int64_t>("9223372036854775808"));
+    ASSERT_TRUE(parses_to<uint64_t>("18446744073709551615", std::numeric_limits<uint64_t>::max()));
+    ASSERT_TRUE(rejects<uint64_t>("18446744073709551616"));
+
+    // The whole string must be a number
+    ASSERT_TRUE(rejects<int>(""));
+    ASSERT_TRUE(rejects<int>("-"));
+    ASSERT_TRUE(rejects<int>("12abc"));
+    ASSERT_TRUE(rejects<int>(" 12"));
+}
+
+
+TEST(TestArguments, IntegerChunks)
+{
+    // 8 digits at a time, mixed with single digits and separators
+    ASSERT_TRUE(parses_to<uint64_t>("1234567890123456789", 1234567890123456789ull));
+    ASSERT_TRUE(parses_to<uint64_t>("12345678_90123456", 1234567890123456ull));
+    ASSERT_TRUE(parses_to<uint64_t>("0xFEDCBA9876543210", 0xFEDCBA9876543210ull));
+    ASSERT_TRUE(parses_to<uint64_t>("0x0123_4567_89ab_cdef", 0x0123456789abcdefull));
+    ASSERT_TRUE(parses_to<uint32_t>("0xffffffff", 0xffffffffu));
+
+    ASSERT_TRUE(rejects<uint32_t>("0x100000000"));
+    ASSERT_TRUE(rejects<uint16_t>("12345678"));
+    ASSERT_TRUE(rejects<uint64_t>("0x1234567g"));
+    ASSERT_TRUE(rejects<uint64_t>("1234567:"));
+    ASSERT_TRUE(parses_to<uint64_t>("12345678901234567890", 12345678901234567890ull));
+    ASSERT_TRUE(parses_to<int64_t>("-0000000000000000001234", -1234));
+    ASSERT_TRUE(rejects<uint64_t>("123456789012345/7"));
+    ASSERT_TRUE(rejects<uint64_t>("99999999999999999999"));
+}
+
+
+//
+// parse_floating_point()
+//
+template <typename T>
+bool converts_to(const std::string &s, const T expected)
+{
+    T value {};
+    return cppargparse::parse_floating_point<T>(s, value) && value == expected;
+}
+
+
+template <typename T>
+bool rejects_floating_point(const std::string &s)
+{
+    T value {};
+    return !cppargparse::parse_floating_point<T>(s, value);
+}
+
+
+TEST(TestArguments, FloatingPointFastPath)
+{
+    ASSERT_TRUE(converts_to<double>("3.25", 3.25));
+    ASSERT_TRUE(converts_to<double>("-0.1", -0.1));
+    ASSERT_TRUE(converts_to<double>("+.5", 0.5));
+    ASSERT_TRUE(converts_to<double>("7.", 7.0));
+    ASSERT_TRUE(converts_to<double>("6.02214076e23", 6.02214076e23));
+    ASSERT_TRUE(converts_to<double>("1E-22", 1e-22));
+    ASSERT_TRUE(converts_to<double>("0e999", 0.0));
+    ASSERT_TRUE(converts_to<float>("2151.1112", 2151.1112f));
+    ASSERT_TRUE(converts_to<long double>("3.63126121", 3.63126121l));
+
+    double zero = 1.0;
+    ASSERT_TRUE(cppargparse::parse_floating_point<double>("-0", zero) && zero == 0.0 && std::signbit(zero));
+}
+
+
+TEST(TestArguments, FloatingPointCorrectRounding)
+{
+    // Outside the fast path: too many digits or inexact powers of 10
+    ASSERT_TRUE(converts_to<double>("1e23", 1e23));
+    ASSERT_TRUE(converts_to<double>("9007199254740993", 9007199254740992.0));
+    ASSERT_TRUE(converts_to<double>("2.2250738585072014e-308", 2.2250738585072014e-308));
+    ASSERT_TRUE(converts_to<double>("0.30000000000000000000001", 0.3));
+    ASSERT_TRUE(converts_to<float>("3.4028234663852886e38", std::numeric_limits<float>::max()));
+    ASSERT_TRUE(converts_to<float>("1.00000005960464477539062500001", 1.0000001f));
+
+    ASSERT_TRUE(converts_to<double>("0x1.8p3", 12.0));
+    ASSERT_TRUE(converts_to<double>("-inf", -std::numeric_limits<double>::infinity()));
+    ASSERT_TRUE(converts_to<double>("Infinity", std::numeric_limits<double>::infinity()));
+
+    double value = 0.0;
+    ASSERT_TRUE(cppargparse::parse_floating_point<double>("nan", value) && std::isnan(value));
+}
+
+
+TEST(TestArguments, FloatingPointInvalid)
+{
+    ASSERT_TRUE(rejects_floating_point<double>(""));
+    ASSERT_TRUE(rejects_floating_point<double>("-"));
+    ASSERT_TRUE(rejects_floating_point<double>("."));
+    ASSERT_TRUE(rejects_floating_point<double>("1e"));
+    ASSERT_TRUE(rejects_floating_point<double>("1.5x"));
+    ASSERT_TRUE(rejects_floating_point<double>("--1"));
+    ASSERT_TRUE(rejects_floating_point<double>("+-1"));
+    ASSERT_TRUE(rejects_floating_point<double>(" 1"));
+    ASSERT_TRUE(rejects_floating_point<double>("1,5"));
+    ASSERT_TRUE(rejects_floating_point<double>("0x"));
+    ASSERT_TRUE(rejects_floating_point<double>("1e400"));
+    ASSERT_TRUE(rejects_floating_point<float>("1e39"));
+}
+
+
+//
+// Bulk conversion of numerical containers
+//
+TEST(TestArguments, NumericalVectorBulk)
+{
+    using namespace cppargparse;
+
+    std::ostringstream cmd;
+    cmd << "--ints";
+
+    for (int i = 0; i < 10000; ++i)
+    {
+        cmd << ' ' << (i * 7919 - 5000000);
+    }
+
+    cmd << " --doubles 0.5 -2.25e3 1e23 0x1p-1";
+
+    auto arg_parser = test::make_arg_parser(test::parse_cmdargs(cmd.str()), "TestArguments");
+    const auto ints = arg_parser.add_arg("--ints");
+    const auto doubles = arg_parser.add_arg("--doubles");
+
+    const auto int_values = arg_parser.get_option<std::vector<int>>(ints);
+    ASSERT_EQ(size_t(10000), int_values.size());
+
+    for (int i = 0; i < 10000; ++i)
+    {
+        ASSERT_EQ(i * 7919 - 5000000, int_values[static_cast<size_t>(i)]);
+    }
+
+    const auto double_values = arg_parser.get_option<std::pmr::vector<double>>(doubles);
+    ASSERT_EQ((std::pmr::vector<double> {0.5, -2250.0, 1e23, 0.5}), double_values);
+}
+
+
+TEST(TestArguments, NumericalVectorBulkFirstError)
+{
+    using namespace cppargparse;
+    parser::ArgumentParser arg_parser("--seq 1 2 x 4 y", "TestArguments");
+
+    const auto seq = arg_parser.add_arg("--seq");
+
+    // Only the first bad value is reported
+    const auto error = test::catch_error([&]() { arg_parser.get_option<std::vector<long>>(seq); });
+    ASSERT_EQ(errors::ErrorCode::InvalidValue, error.code());
+    ASSERT_EQ(size_t(3), error.payload().token);
+    ASSERT_STREQ("x", error.payload().subject);
+
+#if defined(CPPARGPARSE_NO_EXCEPTIONS)
+    // Bad values are converted to their default value
+    errors::clear_error();
+    ASSERT_EQ((std::vector<long> {1, 2, 0, 4, 0}), arg_parser.get_option<std::vector<long>>(seq));
+#endif
+}
+
+
+//
+// Delimiter-separated values
+//
+TEST(TestArguments, DelimitedValues)
+{
+    using namespace cppargparse;
+    parser::ArgumentParser arg_parser("--weights=0.1,0.2 0.3,4e1 --ints 1,2,3 4 --names a,b c --chars ,", "TestArguments");
+
+    const auto weights = arg_parser.add_arg("--weights");
+    const auto ints = arg_parser.add_arg("--ints");
+    const auto names = arg_parser.add_arg("--names");
+    const auto chars = arg_parser.add_arg("--chars");
+
+    ASSERT_EQ((std::vector<double> {0.1, 0.2, 0.3, 40.0}), arg_parser.get_option<std::vector<double>>(weights));
+    ASSERT_EQ((std::list<int> {1, 2, 3, 4}), arg_parser.get_option<std::list<int>>(ints));
+
+    // Strings and characters are never split
+    ASSERT_EQ((std::vector<std::string> {"a,b", "c"}), arg_parser.get_option<std::vector<std::string>>(names));
+    ASSERT_EQ((std::vector<char> {','}), arg_parser.get_option<std::vector<char>>(chars));
+}
+
+
+TEST(TestArguments, DelimitedValuesError)
+{
+    using namespace cppargparse;
+    parser::ArgumentParser arg_parser("--seq 1 2,x,4 --list 1,,2", "TestArguments");
+
+    const auto seq = arg_parser.add_arg("--seq");
+    const auto list = arg_parser.add_arg("--list");
+
+    const auto invalid = test::catch_error([&]() { arg_parser.get_option<std::vector<int>>(seq); });
+    ASSERT_EQ(size_t(2), invalid.payload().token);
+    ASSERT_STREQ("Error: Couldn't convert \"x\" to type <int32_t> (token 2)", invalid.what());
+
+    const auto empty = test::catch_error([&]() { arg_parser.get_option<std::list<int>>(list); });
+    ASSERT_STREQ("Error: Missing value of type <int32_t> (token 4)", empty.what());
+}
+
+
+TEST(TestArguments, Array)
+{
+    using namespace cppargparse;
+    parser::ArgumentParser arg_parser("--origin=1.5,2,3 --range 10 20 30 --short 1,2", "TestArguments");
+
+    const auto origin = arg_parser.add_arg("--origin");
+    const auto range = arg_parser.add_arg("--range");
+    const auto too_short = arg_parser.add_arg("--short");
+
+    const auto origin_values = arg_parser.get_option<std::array<double, 3>>(origin);
+    ASSERT_EQ((std::array<double, 3> {1.5, 2.0, 3.0}), origin_values);
+
+    // Only the first N values are taken
+    const auto range_values = arg_parser.get_option<std::array<int, 2>>(range);
+    ASSERT_EQ((std::array<int, 2> {10, 20}), range_values);
+
+    const auto missing = test::catch_error([&]() { arg_parser.get_option<std::array<int, 3>>(too_short); });
+    ASSERT_EQ(errors::ErrorCode::InvalidValue, missing.code());
+    ASSERT_STREQ("Error: Missing value of type <int32_t> (token 8)", missing.what());
+}
+
+
+TEST(TestArguments, ArrayExactTokens)
+{
+    using namespace cppargparse;
+    parser::ArgumentParser arg_parser("--origin 1 2,3 4 --range 5", "TestArguments");
+
+    const auto origin = arg_parser.add_arg("--origin");
+    const auto range = arg_parser.add_arg("--range");
+
+    // Tokens after the N values are left alone, registered arguments or not
+    const auto origin_values = arg_parser.get_option<std::array<int, 3>>(origin);
+    ASSERT_EQ((std::array<int, 3> {1, 2, 3}), origin_values);
+
+    // Strings aren't split
+    const auto strings = arg_parser.get_option<std::array<std::string, 2>>(origin);
+    ASSERT_EQ((std::array<std::string, 2> {"1", "2,3"}), strings);
+
+    const auto error = test::catch_error([&]() { arg_parser.get_option<std::array<int, 2>>(range); });
+    ASSERT_STREQ("Error: Missing value of type <int32_t> (token 6)", error.what());
+}
+
+
+TEST(TestArguments, ArrayExactValues)
+{
+    using namespace cppargparse;
+    parser::ArgumentParser arg_parser("-a 1,2,3,4 --origin a --verbose b", "TestArguments");
+
+    const auto a = arg_parser.add_arg("-a");
+    const auto origin = arg_parser.add_arg("--origin");
+    const auto verbose = arg_parser.add_arg("--verbose");
+
+    // A token can't hold more values than remain
+    const auto too_many = test::catch_error([&]() { arg_parser.get_option<std::array<int, 2>>(a); });
+    ASSERT_EQ(errors::ErrorCode::InvalidValue, too_many.code());
+    ASSERT_STREQ("Error: Couldn't convert \"1,2,3,4\" to type <int32_t> (token 1)", too_many.what());
+    ASSERT_EQ((std::array<int, 4> {1, 2, 3, 4}), (arg_parser.get_option<std::array<int, 4>>(a)));
+
+    // The values end at the next registered argument
+    const auto missing = test::catch_error([&]() { arg_parser.get_option<std::array<std::string, 2>>(origin); });
+    ASSERT_EQ(errors::ErrorCode::InvalidValue, missing.code());
+    ASSERT_EQ(size_t(4), missing.payload().token);
+    ASSERT_EQ((std::array<std::string, 1> {"a"}), (arg_parser.get_option<std::array<std::string, 1>>(origin)));
+    ASSERT_TRUE(arg_parser.get_flag(verbose));
+}
+
+
+//
+// std::pair, std::tuple
+//
+TEST(TestArguments, Pair)
+{
+    using namespace cppargparse;
+    parser::ArgumentParser arg_parser("--range 10 -20 30 --size 1 --name x 2", "TestArguments");
+
+    const auto range = arg_parser.add_arg("--range");
+    const auto size = arg_parser.add_arg("--size");
+    const auto name = arg_parser.add_arg("--name");
+
+    ASSERT_EQ((std::pair<int, long> {10, -20}), (arg_parser.get_option<std::pair<int, long>>(range)));
+    ASSERT_EQ((std::pair<std::string, int> {"x", 2}), (arg_parser.get_option<std::pair<std::string, int>>(name)));
+
+    const auto invalid = test::catch_error([&]() { arg_parser.get_option<std::pair<int, int>>(size); });
+    ASSERT_STREQ("Error: Couldn't convert \"--name\" to type <int32_t> (token 6)", invalid.what());
+
+    const auto missing = test::catch_error([&]() { arg_parser.get_option<std::pair<std::string, std::string>>(arg_parser.add_arg("2")); });
+    ASSERT_STREQ("Error: Missing value of type <std::string> (token 9)", missing.what());
+}
+
+
+TEST(TestArguments, Tuple)
+{
+    using namespace cppargparse;
+    parser::ArgumentParser arg_parser("--point 1.5 label 0x10 --short 1", "TestArguments");
+
+    const auto point = arg_parser.add_arg("--point");
+    const auto too_short = arg_parser.add_arg("--short");
+
+    const auto values = arg_parser.get_option<std::tuple<float, std::string, unsigned int>>(point);
+    ASSERT_EQ((std::tuple<float, std::string, unsigned int> {1.5f, "label", 16}), values);
+
+    const auto single = arg_parser.get_option<std::tuple<double>>(too_short);
+    ASSERT_EQ(1.0, std::get<0>(single));
+
+    const auto missing = test::catch_error([&]() { arg_parser.get_option<std::tuple<int, int, int>>(too_short); });
+    ASSERT_STREQ("Error: Missing value of type <int32_t> (token 6)", missing.what());
+}
+
+
+//
+// Parallel conversion
+//
+TEST(TestArguments, ParallelConversion)
+{
+    using namespace cppargparse;
+
+    std::ostringstream cmd;
+    cmd << "--doubles";
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        cmd << ' ' << i << ".5," << -i;
+    }
+
+    cmd << " --names";
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        cmd << " name" << i;
+    }
+
+    cmd << " --bad 1 2 x 4 5 6 7 y 9 10";
+
+    auto arg_parser = test::make_arg_parser(test::parse_cmdargs(cmd.str()), "TestArguments");
+    const auto doubles = arg_parser.add_arg("--doubles");
+    const auto names = arg_parser.add_arg("--names");
+    const auto bad = arg_parser.add_arg("--bad");
+
+    const auto previous = parallel::set_conversion_policy({4, 2});
+    const test::ScopeExit restore([&]() { parallel::set_conversion_policy(previous); });
+
+    const auto double_values = arg_parser.get_option<std::vector<double>>(doubles);
+    const auto name_values = arg_parser.get_option<std::vector<std::string>>(names);
+    const auto error = test::catch_error([&]() { arg_parser.get_option<std::vector<int>>(bad); });
+
+    ASSERT_EQ(size_t(2000), double_values.size());
+    ASSERT_EQ(size_t(1000), name_values.size());
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        ASSERT_EQ(i + 0.5, double_values[static_cast<size_t>(2 * i)]);
+        ASSERT_EQ(-i, double_values[static_cast<size_t>(2 * i + 1)]);
+        ASSERT_EQ("name" + std::to_string(i), name_values[static_cast<size_t>(i)]);
+    }
+
+    // The first bad value is reported, no matter which thread finishes first
+    ASSERT_EQ(errors::ErrorCode::InvalidValue, error.code());
+    ASSERT_STREQ("x", error.payload().subject);
+}
+
+
+//
+// Durations
+//
+TEST(TestArguments, Duration)
+{
+    using namespace cppargparse;
+    using namespace std::chrono_literals;
+
+    const auto check = [](const std::string_view &text, const auto expected)
+    {
+        auto value = decltype(expected)::zero();
+        ASSERT_TRUE(parse_duration(text, value)) << text;
+        ASSERT_EQ(expected, value) << text;
+    };
+
+    check("250ms", 250ms);
+    check("1.5s", std::chrono::milliseconds(1500));
+    check(".5h", 30min);
+    check("2d", std::chrono::hours(48));
+    check("3m", std::chrono::seconds(180));
+    check("3min", std::chrono::seconds(180));
+    check("-2s", std::chrono::milliseconds(-2000));
+    check("+7us", std::chrono::nanoseconds(7000));
+    check("7\xC2\xB5s", std::chrono::nanoseconds(7000));
+    check("1.000000000000000000000s", std::chrono::seconds(1));
+    check("0.000000001s", 1ns);
+    check("42", std::chrono::milliseconds(42));
+    check("0.25s", std::chrono::duration<double>(0.25));
+    check("90s", std::chrono::duration<float, std::ratio<60>>(1.5f));
+
+    // Limits are exact
+    check("9223372036854775807ns", std::chrono::nanoseconds(std::numeric_limits<int64_t>::max()));
+    check("-9223372036854775808ns", std::chrono::nanoseconds(std::numeric_limits<int64_t>::min()));
+    check("2147483647s", std::chrono::duration<int32_t>(std::numeric_limits<int32_t>::max()));
+
+    std::chrono::nanoseconds ns;
+    std::chrono::seconds s;
+    std::chrono::duration<int32_t> s32;
+    std::chrono::duration<uint32_t> u32;
+
+    for (const auto *text : {"", "ms", ".", "-", "1.5", "5sec", "5 s", "1e3s", "1..5s", "5S", "1,5s"})
+    {
+        ASSERT_FALSE(parse_duration(text, s)) << text;
+    }
+
+    ASSERT_FALSE(parse_duration("9223372036854775808ns", ns));
+    ASSERT_FALSE(parse_duration("-9223372036854775809ns", ns));
+    ASSERT_FALSE(parse_duration("2147483648s", s32));
+    ASSERT_FALSE(parse_duration("300000d", ns));
+    ASSERT_FALSE(parse_duration("1ms", s));
+    ASSERT_FALSE(parse_duration("-1s", u32));
+    ASSERT_FALSE(parse_duration("12345678901234567890s", s));
+}
+
+
+TEST(TestArguments, DurationOption)
+{
+    using namespace cppargparse;
+    using namespace std::chrono_literals;
+    parser::ArgumentParser arg_parser("--timeout 250ms --backoff 1s,2.5s 10s -x 1ns", "TestArguments");
+
+    const auto timeout = arg_parser.add_arg("--timeout");
+    const auto backoff = arg_parser.add_arg("--backoff");
+    const auto x = arg_parser.add_arg("-x");
+
+    ASSERT_EQ(250ms, arg_parser.get_option<std::chrono::milliseconds>(timeout));
+    ASSERT_EQ((std::vector<std::chrono::milliseconds> {1s, 2500ms, 10s}), arg_parser.get_option<std::vector<std::chrono::milliseconds>>(backoff));
+
+    const auto inexact = test::catch_error([&]() { arg_parser.get_option<std::chrono::milliseconds>(x); });
+    ASSERT_STREQ("Error: Couldn't convert \"1ns\" to type <duration> (token 6)", inexact.what());
+}
+
+
+//
+// Byte sizes
+//
+TEST(TestArguments, ByteSize)
+{
+    using namespace cppargparse;
+
+    const auto check = [](const std::string_view &text, const uint64_t expected)
+    {
+        units::ByteSize value { 0 };
+        ASSERT_TRUE(parse_byte_size(text, value)) << text;
+        ASSERT_EQ(expected, value.bytes) << text;
+    };
+
+    check("512", 512);
+    check("512B", 512);
+    check("64k", 64000);
+    check("64kB", 64000);
+    check("64KB", 64000);
+    check("64KiB", 65536);
+    check("64Ki", 65536);
+    check("1.5GiB", 1610612736);
+    check("4GB", 4000000000);
+    check("0.5MB", 500000);
+    check("15EiB", 15 * (uint64_t(1) << 60));
+    check("18446744073709551615", std::numeric_limits<uint64_t>::max());
+    check("18.446744073709551615EB", std::numeric_limits<uint64_t>::max());
+
+    units::ByteSize value { 0 };
+
+    for (const auto *text : {"", "B", "-1", "1b", "1kb", "1iB", "1KiBB", "1X", "0.3MiB", "1.5B", "18446744073709551616", "16EiB", "19EB"})
+    {
+        ASSERT_FALSE(parse_byte_size(text, value)) << text;
+    }
+}
+
+
+TEST(TestArguments, ByteSizeOption)
+{
+    using namespace cppargparse;
+    parser::ArgumentParser arg_parser("--cache-size 4GiB --buffers 4KiB,64KiB -x 1.5B", "TestArguments");
+
+    const auto cache_size = arg_parser.add_arg("--cache-size");
+    const auto buffers = arg_parser.add_arg("--buffers");
+    const auto x = arg_parser.add_arg("-x");
+
+    ASSERT_EQ(uint64_t(4) << 30, arg_parser.get_option<units::ByteSize>(cache_size).bytes);
+
+    const auto sizes = arg_parser.get_option<std::vector<units::ByteSize>>(buffers);
+    ASSERT_EQ(size_t(2), sizes.size());
+    ASSERT_EQ(uint64_t(65536), sizes[1].bytes);
+
+    const auto inexact = test::catch_error([&]() { arg_parser.get_option<units::ByteSize>(x); });
+    ASSERT_STREQ("Error: Couldn't convert \"1.5B\" to type <byte size> (token 5)", inexact.what());
+}
+
+
+//
+// network
+//
+TEST(TestArguments, IpAddress)
+{
+    using namespace cppargparse;
+
+    network::IpAddress value {};
+
+    ASSERT_TRUE(parse_ip_address("10.0.0.5", value));
+    ASSERT_EQ(network::Family::V4, value.family);
+    ASSERT_EQ(10, value.bytes[0]);
+    ASSERT_EQ(5, value.bytes[3]);
+    ASSERT_EQ(0, value.bytes[4]);
+
+    ASSERT_TRUE(parse_ip_address("2001:db8::1", value));
+    ASSERT_EQ(network::Family::V6, value.family);
+    ASSERT_EQ(0x20, value.bytes[0]);
+    ASSERT_EQ(0x0d, value.bytes[2]);
+    ASSERT_EQ(0xb8, value.bytes[3]);
+    ASSERT_EQ(0, value.bytes[14]);
+    ASSERT_EQ(1, value.bytes[15]);
+
+    network::IpAddress mapped {};
+    ASSERT_TRUE(parse_ip_address("::ffff:10.0.0.5", mapped));
+    ASSERT_EQ(0xff, mapped.bytes[10]);
+    ASSERT_EQ(10, mapped.bytes[12]);
+    ASSERT_EQ(5, mapped.bytes[15]);
+
+    network::IpAddress other {};
+
+    for (const auto *text : {"::", "::1", "1::", "fe80::1:2", "1:2:3:4:5:6:7:8", "1:2:3:4:5:6:1.2.3.4", "ABCD:ef01::", "255.255.255.255"})
+    {
+        ASSERT_TRUE(parse_ip_address(text, value)) << text;
+    }
+
+    ASSERT_TRUE(parse_ip_address("0:0:0:0:0:0:0:1", value));
+    ASSERT_TRUE(parse_ip_address("::1", other));
+    ASSERT_EQ(value, other);
+
+    for (const auto *text : {"", "10.0.0", "10.0.0.5.1", "256.0.0.1", "01.0.0.1", "10..0.1", "10.0.0.", "a.b.c.d",
+                             ":", ":::", "1:::2", "1::2::3", "1:2:3:4:5:6:7", "1:2:3:4:5:6:7:8:9", "1::2:3:4:5:6:7:8",
+                             "12345::", "g::", "1:", ":1", "::1.2.3", "1.2.3.4::", "fe80::1%eth0", "1:2:3:4:5:6:7:8::",
+                             "::1:2:3:4:5:6:7:8"})
+    {
+        ASSERT_FALSE(parse_ip_address(text, value)) << text;
+    }
+}
+
+
+TEST(TestArguments, Endpoint)
+{
+    using namespace cppargparse;
+
+    network::Endpoint value {};
+
+    ASSERT_TRUE(parse_endpoint("10.0.0.5:8080", value));
+    ASSERT_EQ("10.0.0.5", value.host);
+    ASSERT_TRUE(value.numeric);
+    ASSERT_EQ(network::Family::V4, value.address.family);
+    ASSERT_EQ(8080, value.port);
+
+    ASSERT_TRUE(parse_endpoint("[::1]:53", value));
+    ASSERT_EQ("::1", value.host);
+    ASSERT_TRUE(value.numeric);
+    ASSERT_EQ(network::Family::V6, value.address.family);
+    ASSERT_EQ(53, value.port);
+
+    ASSERT_TRUE(parse_endpoint("backend-1.example.com:65535", value));
+    ASSERT_EQ("backend-1.example.com", value.host);
+    ASSERT_FALSE(value.numeric);
+    ASSERT_EQ(65535, value.port);
+
+    ASSERT_TRUE(parse_endpoint("localhost:0", value));
+    ASSERT_EQ("localhost", value.host);
+
+    // Only the last label must have a letter
+    ASSERT_TRUE(parse_endpoint("10.0.0.5x:80", value));
+    ASSERT_FALSE(value.numeric);
+
+    for (const auto *text : {"", "10.0.0.5", "10.0.0.5:", ":80", "10.0.0.5:65536", "10.0.0.5:080", "10.0.0.5:http",
+                             "::1:53", "[::1]", "[10.0.0.5]:80", "[example.com]:80", "[::1:53", "-host:80", "host-:80",
+                             "a..b:80", "under_score:80", "host.:80", "999.999.999.999:443", "10.0.0.500:80", "1.2.3:80",
+                             "example.123:80"})
+    {
+        ASSERT_FALSE(parse_endpoint(text, value)) << text;
+    }
+}
+
+
+TEST(TestArguments, Cidr)
+{
+    using namespace cppargparse;
+
+    network::Cidr value {};
+    network::IpAddress address {};
+
+    ASSERT_TRUE(parse_cidr("10.0.0.0/8", value));
+    ASSERT_EQ(8, value.prefix);
+    ASSERT_TRUE(parse_ip_address("10.255.0.1", address));
+    ASSERT_TRUE(value.contains(address));
+    ASSERT_TRUE(parse_ip_address("11.0.0.1", address));
+    ASSERT_FALSE(value.contains(address));
+    ASSERT_TRUE(parse_ip_address("::a00:1", address));
+    ASSERT_FALSE(value.contains(address));
+
+    ASSERT_TRUE(parse_cidr("192.168.0.0/20", value));
+    ASSERT_TRUE(parse_ip_address("192.168.15.255", address));
+    ASSERT_TRUE(value.contains(address));
+    ASSERT_TRUE(parse_ip_address("192.168.16.0", address));
+    ASSERT_FALSE(value.contains(address));
+
+    ASSERT_TRUE(parse_cidr("fd00::/8", value));
+    ASSERT_TRUE(parse_ip_address("fdab::1", address));
+    ASSERT_TRUE(value.contains(address));
+
+    ASSERT_TRUE(parse_cidr("0.0.0.0/0", value));
+    ASSERT_TRUE(value.contains(address) == false);
+    ASSERT_TRUE(parse_cidr("10.0.0.5/32", value));
+    ASSERT_TRUE(parse_cidr("::1/128", value));
+
+    for (const auto *text : {"", "10.0.0.0", "10.0.0.0/", "10.0.0.0/33", "::/129", "10.0.0.0/08", "10.0.0.5/8",
+                             "192.168.1.0/20", "fd00::1/8", "10.0.0.0/8/8", "/8"})
+    {
+        ASSERT_FALSE(parse_cidr(text, value)) << text;
+    }
+}
+
+
+TEST(TestArguments, NetworkOptions)
+{
+    using namespace cppargparse;
+    parser::ArgumentParser arg_parser(
+            "--backend 10.0.0.5:8080 --backends [::1]:80,example.com:443 10.0.0.6:80 --allow 10.0.0.0/8 -x 10.0.0.5:80,host:port",
+            "TestArguments");
+
+    const auto backend = arg_parser.add_arg("--backend");
+    const auto backends = arg_parser.add_arg("--backends");
+    const auto allow = arg_parser.add_arg("--allow");
+    const auto x = arg_parser.add_arg("-x");
+
+    const auto endpoint = arg_parser.get_option<network::Endpoint>(backend);
+    ASSERT_EQ("10.0.0.5", endpoint.host);
+    ASSERT_EQ(8080, endpoint.port);
+
+    const auto endpoints = arg_parser.get_option<std::vector<network::Endpoint>>(backends);
+    ASSERT_EQ(size_t(3), endpoints.size());
+    ASSERT_EQ("::1", endpoints[0].host);
+    ASSERT_EQ("example.com", endpoints[1].host);
+    ASSERT_EQ(443, endpoints[1].port);
+    ASSERT_EQ(80, endpoints[2].port);
+
+    ASSERT_EQ(8, arg_parser.get_option<network::Cidr>(allow).prefix);
+
+    const auto invalid = test::catch_error([&]() { arg_parser.get_option<std::vector<network::Endpoint>>(x); });
+    ASSERT_STREQ("Error: Couldn't convert \"host:port\" to type <endpoint> (token 8)", invalid.what());
+}
+
+
+//
+// paths
+//
+TEST(TestArguments, CheckedPath)
+{
+    using namespace cppargparse;
+
+    const auto directory = std::filesystem::temp_directory_path() / "cppargparse_test_checked_path";
+    const auto file = directory / "data.csv";
+    const auto missing = directory / "missing.csv";
+
+    std::filesystem::create_directories(directory);
+    std::ofstream(file) << "a,b\n";
+
+    std::filesystem::path path;
+    ASSERT_TRUE(parse_path(missing.string(), path));
+    ASSERT_EQ(missing, path);
+    ASSERT_FALSE(parse_path("", path));
+
+    paths::CheckedPath<paths::RegularFile | paths::Readable> readable_file {};
+    ASSERT_TRUE(parse_checked_path(file.string(), readable_file));
+    ASSERT_EQ(file, readable_file.path);
+    ASSERT_EQ(std::filesystem::file_type::regular, readable_file.status.type);
+    ASSERT_EQ(uintmax_t(4), readable_file.status.size);
+    ASSERT_TRUE(readable_file.status.readable);
+    ASSERT_FALSE(parse_checked_path(directory.string(), readable_file));
+    ASSERT_FALSE(parse_checked_path(missing.string(), readable_file));
+
+    paths::CheckedPath<paths::Directory> existing_directory {};
+    ASSERT_TRUE(parse_checked_path(directory.string(), existing_directory));
+    ASSERT_EQ(std::filesystem::file_type::directory, existing_directory.status.type);
+    ASSERT_EQ(uintmax_t(0), existing_directory.status.size);
+    ASSERT_FALSE(parse_checked_path(file.string(), existing_directory));
+
+    paths::CheckedPath<paths::Exists> existing {};
+    ASSERT_TRUE(parse_checked_path(file.string(), existing));
+    ASSERT_FALSE(existing.status.readable);
+    ASSERT_TRUE(parse_checked_path(directory.string(), existing));
+    ASSERT_FALSE(parse_checked_path(missing.string(), existing));
+
+    // Unchecked paths are still stat'ed once
+    paths::CheckedPath<paths::None> any {};
+    ASSERT_TRUE(parse_checked_path(missing.string(), any));
+    ASSERT_EQ(std::filesystem::file_type::not_found, any.status.type);
+    ASSERT_TRUE(parse_checked_path(file.string(), any));
+    ASSERT_EQ(std::filesystem::file_type::regular, any.status.type);
+
+    ASSERT_STREQ("readable file", argument<paths::CheckedPath<paths::RegularFile | paths::Readable>>::type_name());
+    ASSERT_STREQ("existing directory", argument<paths::CheckedPath<paths::Directory>>::type_name());
+    ASSERT_STREQ("existing path", argument<paths::CheckedPath<paths::Exists>>::type_name());
+    ASSERT_STREQ("path", argument<paths::CheckedPath<paths::None>>::type_name());
+
+    std::filesystem::remove_all(directory);
+}
+
+
+TEST(TestArguments, CheckedPathOption)
+{
+    using namespace cppargparse;
+
+    const auto directory = std::filesystem::temp_directory_path() / "cppargparse_test_checked_path_option";
+    std::filesystem::create_directories(directory);
+
+    std::ostringstream cmd;
+    cmd << "--output " << (directory / "out.csv").string() << " --inputs";
+
+    for (int i = 0; i < 100; ++i)
+    {
+        const auto file = directory / ("input" + std::to_string(i) + ".csv");
+        std::ofstream(file) << i;
+        cmd << ' ' << file.string();
+    }
+
+    cmd << " --bad " << (directory / "input0.csv").string() << ' ' << (directory / "input1.csv").string()
+        << ' ' << (directory / "missing.csv").string() << ' ' << directory.string();
+
+    auto arg_parser = test::make_arg_parser(test::parse_cmdargs(cmd.str()), "TestArguments");
+    const auto output = arg_parser.add_arg("--output");
+    const auto inputs = arg_parser.add_arg("--inputs");
+    const auto bad = arg_parser.add_arg("--bad");
+
+    typedef paths::CheckedPath<paths::RegularFile | paths::Readable> InputPath;
+
+    const auto previous = parallel::set_validation_policy({4, 2});
+    const test::ScopeExit restore([&]() { parallel::set_validation_policy(previous); });
+
+    const auto output_path = arg_parser.get_option<std::filesystem::path>(output);
+    const auto input_paths = arg_parser.get_option<std::vector<InputPath>>(inputs);
+    const auto error = test::catch_error([&]() { arg_parser.get_option<std::vector<InputPath>>(bad); });
+
+    ASSERT_EQ(directory / "out.csv", output_path);
+    ASSERT_EQ(size_t(100), input_paths.size());
+
+    for (size_t i = 0; i < input_paths.size(); ++i)
+    {
+        ASSERT_EQ(directory / ("input" + std::to_string(i) + ".csv"), input_paths[i].path);
+        ASSERT_EQ(uintmax_t(i < 10 ? 1 : 2), input_paths[i].status.size);
+    }
+
+    // Long values are shortened in error messages
+    const std::string message = error.what();
+    ASSERT_NE(std::string::npos, message.find("\" to type <readable file> (token 106)"));
+
+    std::filesystem::remove_all(directory);
+}
+
+//
+// bool
+//
+TEST(TestArguments, BoolWords)
+{
+    using namespace cppargparse;
+
+    const auto check = [](const std::string_view &text, const bool expected)
+    {
+        bool value = !expected;
+        ASSERT_TRUE(boolean::parse_bool(text, value)) << text;
+        ASSERT_EQ(expected, value) << text;
+    };
+
+    for (const auto *word : {"1", "on", "yes", "true", "ON", "Yes", "TRUE"})
+    {
+        check(word, true);
+    }
+
+    for (const auto *word : {"0", "no", "off", "false", "No", "OFF", "False"})
+    {
+        check(word, false);
+    }
+
+    bool value = false;
+
+    for (const auto *word : {"", "2", "y", "n", "tru", "truee", "falsee", "o", "yes!", "O", "\x11", "N\x0f", "auto"})
+    {
+        ASSERT_FALSE(boolean::parse_bool(word, value)) << word;
+    }
+}
+
+
+TEST(TestArguments, Bool)
+{
+    using namespace cppargparse;
+    parser::ArgumentParser arg_parser("--cache=false --compress no --verbose --strip input.txt -x maybe", "TestArguments");
+
+    const auto cache = arg_parser.add_arg("--cache");
+    const auto compress = arg_parser.add_arg("--compress");
+    const auto verbose = arg_parser.add_arg("--verbose");
+    const auto strip = arg_parser.add_arg("--strip");
+    const auto x = arg_parser.add_arg("-x");
+
+    ASSERT_FALSE(arg_parser.get_option<bool>(cache));
+    ASSERT_FALSE(arg_parser.get_option<bool>(compress));
+
+    // Without a value, options are true and don't consume the next token
+    ASSERT_TRUE(arg_parser.get_option<bool>(verbose));
+    ASSERT_TRUE(arg_parser.get_option<bool>(strip));
+    ASSERT_TRUE(arg_parser.get_option<bool>(x));
+
+    const auto invalid = test::catch_error([&]() { arg_parser.get_option<std::vector<bool>>(x); });
+    ASSERT_STREQ("Error: Couldn't convert \"maybe\" to type <bool> (token 8)", invalid.what());
+}
+
+
+TEST(TestArguments, BoolNegation)
+{
+    using namespace cppargparse;
+    parser::ArgumentParser arg_parser("--no-cache --files a b --no-color --color=auto --no-strip -v --verbose off", "TestArguments");
+
+    const auto cache = arg_parser.add_bool("--cache");
+    const auto files = arg_parser.add_arg("--files");
+    const auto color = arg_parser.add_bool("-c", "--color");
+    const auto no_strip = arg_parser.add_arg("--no-strip");
+    const auto verbose = arg_parser.add_bool("-v", "--verbose");
+    const auto plain = arg_parser.add_bool("--plain");
+
+    ASSERT_FALSE(arg_parser.get_option<bool>(cache));
+    ASSERT_TRUE(arg_parser.get_option<bool>(cache, true) == false);
+
+    // Negations end the values of other options
+    ASSERT_EQ((std::vector<std::string> {"a", "b"}), arg_parser.get_option<std::vector<std::string>>(files));
+
+    // The last occurrence wins
+    ASSERT_EQ(std::nullopt, arg_parser.get_option<std::optional<bool>>(color));
+    ASSERT_EQ((std::vector<std::optional<bool>> {false, std::nullopt}), arg_parser.get_all<std::optional<bool>>(color));
+    ASSERT_FALSE(arg_parser.get_option<bool>(verbose));
+    ASSERT_EQ(size_t(2), arg_parser.count(verbose));
+
+    // Registered IDs starting with "--no-" aren't negations
+    ASSERT_TRUE(arg_parser.get_option<bool>(no_strip));
+
+    ASSERT_EQ(std::optional<bool>(), arg_parser.get_option<std::optional<bool>>(plain, std::nullopt));
+
+    arg_parser.reset("--plain --no-plain");
+    ASSERT_FALSE(arg_parser.get_option<bool>(plain));
+
+    parser::ArgumentParser copy(arg_parser);
+    ASSERT_FALSE(copy.get_option<bool>(plain));
+}
+
+
+//
+// Enums
+//
+enum class Mode
+{
+    Fast,
+    Safe,
+    Debug
+};
+
+CPPARGPARSE_ENUM_ARGUMENT(Mode, {"fast", Mode::Fast}, {"safe", Mode::Safe}, {"debug", Mode::Debug});
+
+
+enum Level
+{
+    LevelNone,
+    LevelLow,
+    LevelHigh
+};
+
+CPPARGPARSE_ENUM_ARGUMENT(Level, {"none", LevelNone}, {"low", LevelLow}, {"lo", LevelLow}, {"high", LevelHigh});
+
+
+TEST(TestArguments, Enum)
+{
+    using namespace cppargparse;
+    parser::ArgumentParser arg_parser("--mode safe -l lo --modes debug fast -x Fast -y", "TestArguments");
+
+    const auto mode = arg_parser.add_arg("--mode");
+    const auto level = arg_parser.add_arg("-l");
+    const auto modes = arg_parser.add_arg("--modes");
+    const auto invalid = arg_parser.add_arg("-x");
+    const auto missing = arg_parser.add_arg("-y");
+
+    ASSERT_EQ(Mode::Safe, arg_parser.get_option<Mode>(mode));
+    ASSERT_EQ(LevelLow, arg_parser.get_option<Level>(level));
+    ASSERT_EQ((std::vector<Mode> {Mode::Debug, Mode::Fast}), arg_parser.get_option<std::vector<Mode>>(modes));
+    ASSERT_EQ(Mode::Debug, arg_parser.get_option<Mode>(invalid, Mode::Debug));
+
+    // Names are case-sensitive
+    const auto case_error = test::catch_error([&]() { arg_parser.get_option<Mode>(invalid); });
+    ASSERT_STREQ("Error: Couldn't convert \"Fast\" to type <fast|safe|debug> (token 8)", case_error.what());
+
+    const auto missing_error = test::catch_error([&]() { arg_parser.get_option<Level>(missing); });
+    ASSERT_STREQ("Error: Missing value of type <none|low|lo|high> (token 10)", missing_error.what());
+
+    Mode value = Mode::Fast;
+    ASSERT_FALSE(enumeration::find<Mode>("", value));
+    ASSERT_FALSE(enumeration::find<Mode>("fastest", value));
+    ASSERT_TRUE(enumeration::find<Mode>("debug", value));
+    ASSERT_EQ(Mode::Debug, value);
+}
+
+
+//
+// Containers
+//
+TEST(TestArguments, Containers)
+{
+    using namespace cppargparse;
+    parser::ArgumentParser arg_parser("--ints 3 1,2 3 --names b a b --keys 1 2 255 -n name", "TestArguments");
+
+    const auto ints = arg_parser.add_arg("--ints");
+    const auto names = arg_parser.add_arg("--names");
+    const auto keys = arg_parser.add_arg("--keys");
+    const auto name = arg_parser.add_arg("-n");
+
+    ASSERT_EQ((std::deque<int> {3, 1, 2, 3}), arg_parser.get_option<std::deque<int>>(ints));
+    ASSERT_EQ((std::set<int> {1, 2, 3}), arg_parser.get_option<std::set<int>>(ints));
+    ASSERT_EQ((std::set<long, std::greater<long>> {3, 2, 1}), (arg_parser.get_option<std::set<long, std::greater<long>>>(ints)));
+    ASSERT_EQ((std::unordered_set<std::string> {"a", "b"}), arg_parser.get_option<std::unordered_set<std::string>>(names));
+    ASSERT_EQ((std::pmr::vector<std::string> {"b", "a", "b"}), arg_parser.get_option<std::pmr::vector<std::string>>(names));
+
+    // Exact capacity
+    ASSERT_EQ(size_t(4), arg_parser.get_option<std::vector<int>>(ints).capacity());
+
+    // One 8-bit integer per value, strings of char are single values
+    const auto unsigned_keys = arg_parser.get_option<std::basic_string<unsigned char>>(keys);
+    ASSERT_EQ((std::basic_string<unsigned char> {1, 2, 255}), unsigned_keys);
+    ASSERT_EQ("name", arg_parser.get_option<std::pmr::string>(name));
+}
+
+
+TEST(TestArguments, ContainersError)
+{
+    using namespace cppargparse;
+    parser::ArgumentParser arg_parser("--ints 1 x 2 y", "TestArguments");
+
+    const auto ints = arg_parser.add_arg("--ints");
+
+    const auto invalid = test::catch_error([&]() { arg_parser.get_option<std::unordered_set<int>>(ints); });
+    ASSERT_STREQ("Error: Couldn't convert \"x\" to type <int32_t> (token 2)", invalid.what());
+
+    const auto invalid_deque = test::catch_error([&]() { arg_parser.get_option<std::deque<short>>(ints); });
+    ASSERT_STREQ("Error: Couldn't convert \"x\" to type <int16_t> (token 2)", invalid_deque.what());
+}
+
+
+//
+// "key=value" definitions
+//
+TEST(TestArguments, Definitions)
+{
+    using namespace cppargparse;
+    parser::ArgumentParser arg_parser("-D level=3 -t 1 --define rate=0.5 -D NDEBUG -D level=4 -D name=a=b", "TestArguments");
+
+    const auto define = arg_parser.add_arg("-D", "--define");
+    arg_parser.add_arg("-t");
+
+    const auto strings = arg_parser.get_option<std::unordered_map<std::string, std::string>>(define);
+    ASSERT_EQ((std::unordered_map<std::string, std::string> {{"level", "4"}, {"rate", "0.5"}, {"NDEBUG", ""}, {"name", "a=b"}}), strings);
+
+    const auto flat = arg_parser.get_option<containers::FlatMap<std::string>>(define);
+    ASSERT_EQ(size_t(4), flat.size());
+    ASSERT_EQ("4", flat.find("level")->second);
+    ASSERT_EQ("a=b", flat.find("name")->second);
+
+    // Command line order of first definition
+    std::vector<std::string> keys;
+
+    for (const auto &entry : flat)
+    {
+        keys.emplace_back(entry.first);
+    }
+
+    ASSERT_EQ((std::vector<std::string> {"level", "rate", "NDEBUG", "name"}), keys);
+}
+
+
+TEST(TestArguments, DefinitionsConverted)
+{
+    using namespace cppargparse;
+    parser::ArgumentParser arg_parser("-D width=0x10 -D height=20 -S x=1.5 -S y -E", "TestArguments");
+
+    const auto define = arg_parser.add_arg("-D");
+    const auto scale = arg_parser.add_arg("-S");
+    const auto empty = arg_parser.add_arg("-E");
+
+    const auto ints = arg_parser.get_option<std::pmr::unordered_map<std::string, int>>(define);
+    ASSERT_EQ(size_t(2), ints.size());
+    ASSERT_EQ(16, ints.at("width"));
+    ASSERT_EQ(20, ints.at("height"));
+
+    const auto flat = arg_parser.get_option<containers::FlatMap<long>>(define);
+    ASSERT_EQ(16, flat.find("width")->second);
+
+    const auto missing_value = test::catch_error([&]() { arg_parser.get_option<std::unordered_map<std::string, double>>(scale); });
+    ASSERT_STREQ("Error: Missing value of type <double> (token 7)", missing_value.what());
+
+    const auto missing = test::catch_error([&]() { arg_parser.get_option<containers::FlatMap<std::string>>(empty); });
+    ASSERT_STREQ("Error: Missing value of type <std::string> (token 9)", missing.what());
+}
+
+
 //
 // float
 //
@@ -917,7 +2026,7 @@ TEST(TestArguments, StringReachEnd)
     auto arg_parser = test::make_arg_parser(test::parse_cmdargs("--text THIS IS SAMPLE TEXT -c"), "TestArguments");
 
     const auto c = arg_parser.add_arg("-c");
-    ASSERT_THROW(arg_parser.get_option<std::string>(c), errors::CommandLineOptionError);
+    ASSERT_ERROR(arg_parser.get_option<std::string>(c), errors::CommandLineOptionError);
 }
 
 TEST(TestArguments, StringVector)
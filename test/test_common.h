@@ -4,27 +4,47 @@
 #include <cstring>
 #include <iterator>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 #include <cppargparse/cppargparse.h>
 
 
+//
+// ASSERT_THROW() counterpart which also works without exceptions:
+// the statement must report an error of the given error class.
+//
+#if defined(CPPARGPARSE_NO_EXCEPTIONS)
+#define ASSERT_ERROR(statement, error_class) \
+    do \
+    { \
+        cppargparse::errors::clear_error(); \
+        statement; \
+        ASSERT_EQ(error_class::error_code, cppargparse::errors::last_error().code); \
+    } while (false)
+#else
+#define ASSERT_ERROR(statement, error_class) ASSERT_THROW(statement, error_class)
+#endif
+
+
 namespace cppargparse {
 namespace test {
 
 
-std::vector<std::string> get_cmdargs(const std::string &command_line)
+inline std::vector<std::string> get_cmdargs(const std::string &command_line)
 {
-    std::istringstream tokens(command_line);
+    std::string buffer(command_line);
+    const std::vector<std::string_view> tokens = tokenizer::tokenize(buffer);
 
     return {
-        std::istream_iterator<std::string> {tokens},
-        std::istream_iterator<std::string> {}
+        tokens.cbegin(),
+        tokens.cend()
     };
 }
 
 
-char *get_cmd_chars(const std::string &token)
+inline char *get_cmd_chars(const std::string &token)
 {
    char *chars = new char[token.size() + 1];
    std::strcpy(chars, token.c_str());
@@ -33,7 +53,7 @@ char *get_cmd_chars(const std::string &token)
 }
 
 
-std::vector<char *> parse_cmdargs(const std::string &command_line)
+inline std::vector<char *> parse_cmdargs(const std::string &command_line)
 {
     std::vector<std::string> command_line_tokens = get_cmdargs(command_line);
 
@@ -44,7 +64,7 @@ std::vector<char *> parse_cmdargs(const std::string &command_line)
 }
 
 
-cppargparse::parser::ArgumentParser make_arg_parser(
+inline cppargparse::parser::ArgumentParser make_arg_parser(
                 std::vector<char *> cmdargs,
                 const std::string &application_description)
 {
@@ -62,6 +82,57 @@ cppargparse::parser::ArgumentParser make_arg_parser(
 }
 
 
+template <typename Function>
+errors::Error catch_error(Function &&function)
+{
+#if defined(CPPARGPARSE_NO_EXCEPTIONS)
+    errors::clear_error();
+    function();
+
+    return errors::Error(errors::last_error());
+#else
+    try
+    {
+        function();
+    }
+
+    catch (const errors::Error &error)
+    {
+        return error;
+    }
+
+    return errors::Error(errors::make_payload(errors::ErrorCode::None, errors::no_index, errors::no_index, nullptr, std::string_view()));
+#endif
+}
+
+
+//
+// Call a function when leaving the scope, so global state is restored even if an ASSERT fails:
+//
+//     const test::ScopeExit restore([&]() { std::pmr::set_default_resource(previous); });
+//
+template <typename Function>
+class ScopeExit
+{
+public:
+    explicit ScopeExit(Function function)
+        : m_function(std::move(function))
+    {
+    }
+
+    ScopeExit(const ScopeExit &) = delete;
+    ScopeExit &operator=(const ScopeExit &) = delete;
+
+    ~ScopeExit()
+    {
+        m_function();
+    }
+
+private:
+    Function m_function;
+};
+
+
 } // namespace test
 } // namespace cppargparse
 
@@ -0,0 +1,85 @@
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <cppargparse/flat_map.h>
+
+
+//
+// insert_or_assign(), find()
+//
+TEST(TestFlatMap, InsertOrAssign)
+{
+    using namespace cppargparse;
+    containers::FlatMap<int> map;
+
+    ASSERT_TRUE(map.empty());
+    ASSERT_FALSE(map.contains("a"));
+
+    ASSERT_TRUE(map.insert_or_assign("a", 1).second);
+    ASSERT_TRUE(map.insert_or_assign("b", 2).second);
+
+    const auto assigned = map.insert_or_assign("a", 3);
+    ASSERT_FALSE(assigned.second);
+    ASSERT_EQ(3, assigned.first->second);
+
+    ASSERT_EQ(size_t(2), map.size());
+    ASSERT_EQ(3, map.find("a")->second);
+    ASSERT_EQ(2, map.find(std::string_view("b"))->second);
+    ASSERT_EQ(map.end(), map.find("c"));
+}
+
+
+//
+// Growth and insertion order
+//
+TEST(TestFlatMap, Growth)
+{
+    using namespace cppargparse;
+    containers::FlatMap<std::string> map;
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        map.insert_or_assign("key" + std::to_string(i), std::to_string(i));
+    }
+
+    ASSERT_EQ(size_t(1000), map.size());
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        ASSERT_EQ(std::to_string(i), map.find("key" + std::to_string(i))->second);
+    }
+
+    int i = 0;
+
+    for (const auto &entry : map)
+    {
+        ASSERT_EQ("key" + std::to_string(i++), entry.first);
+    }
+}
+
+
+//
+// reserve()
+//
+TEST(TestFlatMap, Reserve)
+{
+    using namespace cppargparse;
+    containers::FlatMap<int> map;
+
+    map.insert_or_assign("first", 1);
+    map.reserve(101);
+
+    const auto *entries = &*map.begin();
+
+    for (int i = 0; i < 100; ++i)
+    {
+        map.insert_or_assign(std::to_string(i), std::move(i));
+    }
+
+    // Reserved entries don't move
+    ASSERT_EQ(entries, &*map.begin());
+    ASSERT_EQ(1, map.find("first")->second);
+    ASSERT_EQ(99, map.find("99")->second);
+}
@@ -0,0 +1,66 @@
+#include <string>
+#include <string_view>
+
+#include <gtest/gtest.h>
+
+#include <cppargparse/cppargparse.h>
+
+#include "test_common.h"
+
+
+namespace {
+
+
+static constexpr std::string_view description = "TestLayout";
+
+static constexpr cppargparse::layout::ArgumentSpec arguments[] = {
+    {"-h", "--help", "Display this information"},
+    {"-t", "--time", "The time..."},
+    {"-ü", "--grüße", "Grüße"},
+    {"-x", "", ""}
+};
+
+
+static constexpr auto usage = cppargparse::layout::make_usage<description, arguments>();
+
+
+} // namespace
+
+
+//
+// make_usage()
+//
+TEST(TestLayout, MakeUsage)
+{
+    static_assert(usage.view().substr(0, 19) == "Usage: TestLayout\n\n", "The usage string is rendered at compile time");
+    static_assert(usage.size() == usage.view().size(), "The size excludes the null character");
+
+    const std::string expected =
+            "Usage: TestLayout\n"
+            "\n"
+            "  -h|--help    Display this information\n"
+            "  -t|--time    The time...\n"
+            "  -ü|--grüße   Grüße\n"
+            "  -x           \n";
+
+    ASSERT_EQ(expected, usage.view());
+    ASSERT_EQ(expected, usage.c_str());
+}
+
+
+//
+// make_usage() matches usage()
+//
+TEST(TestLayout, MatchesParserUsage)
+{
+    using namespace cppargparse;
+    auto arg_parser = test::make_arg_parser(test::parse_cmdargs("-t 3"), std::string(description));
+
+    for (const auto &argument : arguments)
+    {
+        arg_parser.add_arg(argument);
+    }
+
+    ASSERT_EQ(arg_parser.usage(), usage.view());
+    ASSERT_EQ("3", arg_parser.get_option<std::string>(arg_parser.add_arg(arguments[1])));
+}
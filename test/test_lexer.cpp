@@ -0,0 +1,159 @@
+#include <string_view>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <cppargparse/cppargparse.h>
+
+#include "test_common.h"
+
+
+//
+// Lex a list of raw tokens against a list of registered IDs and return the normalised command line
+//
+cppargparse::cmd::CommandLine_t lex(const std::vector<std::string_view> &tokens, const std::vector<std::string> &ids = {})
+{
+    cppargparse::cmd::CommandLineArguments_t cmdargs;
+    cppargparse::cmd::CommandLine_t cmd;
+
+    for (const auto &id : ids)
+    {
+        cmdargs.emplace_back(id, std::string(), std::string(), cmd.cend());
+    }
+
+    cppargparse::lexer::lex(tokens.cbegin(), tokens.cend(), cmdargs, cmd);
+
+    return cmd;
+}
+
+
+//
+// Plain tokens
+//
+TEST(TestLexer, Verbatim)
+{
+    const cppargparse::cmd::CommandLine_t expected {
+        "-t", "3", "--time", "-3", "-1.5", "-", "value=x", "-O2"
+    };
+
+    ASSERT_EQ(expected, lex({"-t", "3", "--time", "-3", "-1.5", "-", "value=x", "-O2"}, {"-t", "--time"}));
+
+    // Nothing is split before the IDs are registered
+    const cppargparse::cmd::CommandLine_t unregistered {
+        "-xvf", "--threads=8", "-Dlevel=3"
+    };
+
+    ASSERT_EQ(unregistered, lex({"-xvf", "--threads=8", "-Dlevel=3"}));
+}
+
+
+//
+// Short option clusters
+//
+TEST(TestLexer, Cluster)
+{
+    const cppargparse::cmd::CommandLine_t expected {
+        "-x", "-v", "-f", "archive.tar", "-v", "-v", "-v"
+    };
+
+    ASSERT_EQ(expected, lex({"-xvf", "archive.tar", "-vvv"}, {"-x", "-v", "-f"}));
+
+    // Clusters with an unregistered letter stay whole
+    const cppargparse::cmd::CommandLine_t partial {
+        "-xvz", "-v", "-v"
+    };
+
+    ASSERT_EQ(partial, lex({"-xvz", "-vv"}, {"-v", "-z"}));
+}
+
+
+//
+// Registered multi-letter single-dash IDs
+//
+TEST(TestLexer, SingleDashID)
+{
+    const cppargparse::cmd::CommandLine_t expected {
+        "-name", "foo", "-Werror", "-m"
+    };
+
+    ASSERT_EQ(expected, lex({"-name", "foo", "-Werror", "-m"}, {"-name", "-Werror", "-m"}));
+
+    // Whole registered IDs take precedence over clusters
+    ASSERT_EQ(expected, lex({"-name", "foo", "-Werror", "-m"}, {"-n", "-a", "-m", "-e", "-name", "-Werror"}));
+}
+
+
+//
+// Registered one-letter options followed by their value
+//
+TEST(TestLexer, AttachedValue)
+{
+    const cppargparse::cmd::CommandLine_t expected {
+        "-D", "name=app", "-D", "level=3", "-j", "8", "-D", "x", "-k8"
+    };
+
+    ASSERT_EQ(expected, lex({"-D", "name=app", "-Dlevel=3", "-j8", "-D=x", "-k8"}, {"-D", "-j"}));
+}
+
+
+//
+// "="-joined values
+//
+TEST(TestLexer, JoinedValue)
+{
+    const cppargparse::cmd::CommandLine_t expected {
+        "--threads", "8", "-o", "out.txt", "--define", "key=value", "--empty", "", "--=x"
+    };
+
+    ASSERT_EQ(expected, lex({"--threads=8", "-o=out.txt", "--define=key=value", "--empty=", "--=x"}, {"--threads", "-o", "--define", "--empty"}));
+
+    // Unregistered IDs keep their value
+    const cppargparse::cmd::CommandLine_t unregistered {
+        "--level=3", "-Wl,-rpath=x"
+    };
+
+    ASSERT_EQ(unregistered, lex({"--level=3", "-Wl,-rpath=x"}, {"--threads"}));
+}
+
+
+//
+// Joined values are views into the original token
+//
+TEST(TestLexer, JoinedValueIsView)
+{
+    const std::string_view token = "--threads=8";
+    const auto cmd = lex({token}, {"--threads"});
+
+    ASSERT_EQ(token.data(), cmd.at(0).data());
+    ASSERT_EQ(token.data() + 10, cmd.at(1).data());
+}
+
+
+//
+// Tokens after "--" are not lexed
+//
+TEST(TestLexer, Terminator)
+{
+    const cppargparse::cmd::CommandLine_t expected {
+        "-x", "-v", "--", "-xvf", "--threads=8"
+    };
+
+    ASSERT_EQ(expected, lex({"-xv", "--", "-xvf", "--threads=8"}, {"-x", "-v", "-f", "--threads"}));
+}
+
+
+//
+// Negated long options
+//
+TEST(TestLexer, Negation)
+{
+    using namespace cppargparse;
+
+    ASSERT_TRUE(lexer::is_negation("--no-cache", "--cache"));
+    ASSERT_FALSE(lexer::is_negation("--cache", "--cache"));
+    ASSERT_FALSE(lexer::is_negation("--no-cache", "--cach"));
+    ASSERT_FALSE(lexer::is_negation("--no-c", "-c"));
+    ASSERT_FALSE(lexer::is_negation("--no-", "--"));
+    ASSERT_FALSE(lexer::is_negation("--no-cache", ""));
+    ASSERT_FALSE(lexer::is_negation("--na-cache", "--cache"));
+}
@@ -0,0 +1,121 @@
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <cppargparse/parallel.h>
+
+#include "test_common.h"
+
+
+//
+// chunk_count()
+//
+TEST(TestParallel, ChunkCount)
+{
+    using namespace cppargparse;
+
+    ASSERT_EQ(1u, parallel::chunk_count(1000000, {1, 1000}));
+    ASSERT_EQ(1u, parallel::chunk_count(0, {8, 1000}));
+    ASSERT_EQ(1u, parallel::chunk_count(1999, {8, 1000}));
+    ASSERT_EQ(2u, parallel::chunk_count(2000, {8, 1000}));
+    ASSERT_EQ(8u, parallel::chunk_count(1000000, {8, 1000}));
+    ASSERT_EQ(8u, parallel::chunk_count(8, {8, 0}));
+}
+
+
+//
+// for_each_chunk()
+//
+TEST(TestParallel, ForEachChunk)
+{
+    using namespace cppargparse;
+
+    std::vector<int> calls(16, 0);
+    std::atomic<int> total(0);
+
+    parallel::for_each_chunk(calls.size(), [&](const size_t chunk)
+    {
+        ++calls[chunk];
+        ++total;
+    });
+
+    ASSERT_EQ(std::vector<int>(16, 1), calls);
+    ASSERT_EQ(16, total.load());
+}
+
+
+#if !defined(CPPARGPARSE_NO_EXCEPTIONS)
+TEST(TestParallel, ForEachChunkException)
+{
+    using namespace cppargparse;
+
+    std::atomic<int> total(0);
+
+    // Every chunk runs to completion, the lowest chunk's exception wins
+    try
+    {
+        parallel::for_each_chunk(8, [&](const size_t chunk)
+        {
+            ++total;
+
+            if (chunk == 3 || chunk == 6)
+            {
+                throw std::runtime_error(std::to_string(chunk));
+            }
+        });
+
+        FAIL();
+    }
+
+    catch (const std::runtime_error &error)
+    {
+        ASSERT_STREQ("3", error.what());
+    }
+
+    ASSERT_EQ(8, total.load());
+}
+#endif
+
+
+//
+// set_conversion_policy()
+//
+TEST(TestParallel, ConversionPolicy)
+{
+    using namespace cppargparse;
+
+    ASSERT_EQ(1u, parallel::conversion_policy().threads);
+
+    const auto previous = parallel::set_conversion_policy({4, 10});
+    const test::ScopeExit restore([&]() { parallel::set_conversion_policy(previous); });
+
+    ASSERT_EQ(4u, parallel::conversion_policy().threads);
+    ASSERT_EQ(10u, parallel::conversion_policy().min_chunk_size);
+
+    parallel::set_conversion_policy(previous);
+    ASSERT_EQ(1u, parallel::conversion_policy().threads);
+}
+
+
+//
+// set_validation_policy()
+//
+TEST(TestParallel, ValidationPolicy)
+{
+    using namespace cppargparse;
+
+    ASSERT_EQ(1u, parallel::validation_policy().threads);
+    ASSERT_EQ(256u, parallel::validation_policy().min_chunk_size);
+
+    const auto previous = parallel::set_validation_policy({16, 4});
+    const test::ScopeExit restore([&]() { parallel::set_validation_policy(previous); });
+
+    ASSERT_EQ(16u, parallel::validation_policy().threads);
+    ASSERT_EQ(4u, parallel::validation_policy().min_chunk_size);
+    ASSERT_EQ(1u, parallel::conversion_policy().threads);
+
+    parallel::set_validation_policy(previous);
+    ASSERT_EQ(1u, parallel::validation_policy().threads);
+}
@@ -1,3 +1,12 @@
+#include <array>
+#include <cstddef>
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #define private public
@@ -20,6 +29,29 @@ TEST(TestParser, Constructor)
 }
 
 
+//
+// Constructor (command string)
+//
+TEST(TestParser, ConstructorCommandString)
+{
+    using namespace cppargparse;
+    parser::ArgumentParser arg_parser("-t 3 --name 'My Name' -x=\"a b\"", "TestParser");
+
+    // "-x=a b" is split once "-x" is registered
+    ASSERT_EQ(size_t(5), arg_parser.m_cmd.size());
+
+    const auto name = arg_parser.add_arg("-n", "--name");
+    const auto x = arg_parser.add_arg("-x");
+
+    ASSERT_EQ(size_t(6), arg_parser.m_cmd.size());
+
+    ASSERT_EQ("My Name", arg_parser.get_option<std::string>(name));
+    ASSERT_EQ("a b", arg_parser.get_option<std::string>(x));
+
+    ASSERT_ERROR(parser::ArgumentParser("-t 'open", "TestParser"), errors::CommandLineSyntaxError);
+}
+
+
 //
 // add_arg() 1
 //
@@ -172,7 +204,7 @@ TEST(TestParser, GetOption2)
     auto arg_parser = test::make_arg_parser(test::parse_cmdargs("-t 60"), "TestParser");
 
     const auto arg = arg_parser.add_arg("-f", "--frozen", "Frozen state");
-    ASSERT_THROW(arg_parser.get_option<int>(arg), errors::CommandLineArgumentError);
+    ASSERT_ERROR(arg_parser.get_option<int>(arg), errors::CommandLineArgumentError);
 }
 
 
@@ -202,6 +234,587 @@ TEST(TestParser, GetOption4)
 }
 
 
+//
+// get_all()
+//
+TEST(TestParser, GetAll)
+{
+    using namespace cppargparse;
+    auto arg_parser = test::make_arg_parser(test::parse_cmdargs("-I a -t 60 --include b -I c"), "TestParser");
+
+    const auto arg = arg_parser.add_arg("-I", "--include", "Include directory");
+    arg_parser.add_arg("-t", "--time", "The time...");
+
+    const std::vector<std::string> expected {"a", "b", "c"};
+    ASSERT_EQ(expected, arg_parser.get_all<std::string>(arg));
+    ASSERT_EQ("a", arg_parser.get_option<std::string>(arg));
+
+    const auto missing = arg_parser.add_arg("-f", "--frozen", "Frozen state");
+    ASSERT_TRUE(arg_parser.get_all<int>(missing).empty());
+}
+
+
+//
+// count()
+//
+TEST(TestParser, Count)
+{
+    using namespace cppargparse;
+    auto arg_parser = test::make_arg_parser(test::parse_cmdargs("-v -t 60 --verbose -v"), "TestParser");
+
+    const auto verbose = arg_parser.add_arg("-v", "--verbose", "Verbosity level");
+    ASSERT_EQ(size_t(3), arg_parser.count(verbose));
+
+    const auto help = arg_parser.add_help();
+    ASSERT_EQ(size_t(0), arg_parser.count(help));
+
+    // Empty argv entries aren't occurrences of arguments without an alternative ID
+    std::vector<char *> argv = test::parse_cmdargs("-q -q");
+    argv.insert(argv.begin() + 1, new char[1]());
+    argv.push_back(new char[1]());
+
+    auto empty_parser = test::make_arg_parser(argv, "TestParser");
+    const auto quiet = empty_parser.add_arg("-q");
+
+    ASSERT_EQ(size_t(2), empty_parser.count(quiet));
+    ASSERT_EQ(size_t(2), empty_parser.get_all<std::string>(quiet).size());
+}
+
+
+//
+// Short option clusters and "="-joined values
+//
+TEST(TestParser, LexedCommandLine)
+{
+    using namespace cppargparse;
+    auto arg_parser = test::make_arg_parser(test::parse_cmdargs("-xvf archive.tar --threads=8 -vv"), "TestParser");
+
+    const auto x = arg_parser.add_arg("-x", "--extract");
+    const auto v = arg_parser.add_arg("-v", "--verbose");
+    const auto f = arg_parser.add_arg("-f", "--file");
+    const auto threads = arg_parser.add_arg("-j", "--threads");
+
+    ASSERT_TRUE(arg_parser.get_flag(x));
+    ASSERT_EQ(size_t(3), arg_parser.count(v));
+    ASSERT_EQ("archive.tar", arg_parser.get_option<std::string>(f));
+    ASSERT_EQ(8, arg_parser.get_option<int>(threads));
+}
+
+
+//
+// Multi-letter single-dash IDs match whole tokens
+//
+TEST(TestParser, SingleDashID)
+{
+    using namespace cppargparse;
+    auto arg_parser = test::make_arg_parser(test::parse_cmdargs("-name foo -Werror -m -nm"), "TestParser");
+
+    const auto name = arg_parser.add_arg("-name");
+    const auto werror = arg_parser.add_arg("-Werror");
+    const auto m = arg_parser.add_arg("-m");
+
+    ASSERT_TRUE(arg_parser.get_flag(name));
+    ASSERT_TRUE(arg_parser.get_flag(werror));
+    ASSERT_EQ("foo", arg_parser.get_option<std::string>(name));
+    ASSERT_EQ(size_t(1), arg_parser.count(m));
+
+    // Registering "-n" completes the cluster "-nm", the command line is lexed again
+    const auto n = arg_parser.add_arg("-n");
+
+    ASSERT_EQ(size_t(1), arg_parser.count(n));
+    ASSERT_EQ(size_t(2), arg_parser.count(m));
+    ASSERT_EQ("foo", arg_parser.get_option<std::string>(name));
+    ASSERT_TRUE(arg_parser.get_flag(werror));
+}
+
+
+//
+// Values attached to one-letter options
+//
+TEST(TestParser, AttachedValue)
+{
+    using namespace cppargparse;
+    auto arg_parser = test::make_arg_parser(test::parse_cmdargs("-D name=app -Dlevel=3 -j8"), "TestParser");
+
+    const auto define = arg_parser.add_arg("-D");
+    const auto jobs = arg_parser.add_arg("-j");
+
+    const auto definitions = arg_parser.get_option<std::unordered_map<std::string, std::string>>(define);
+    ASSERT_EQ((std::unordered_map<std::string, std::string> {{"name", "app"}, {"level", "3"}}), definitions);
+    ASSERT_EQ(8, arg_parser.get_option<int>(jobs));
+}
+
+
+//
+// Tokens after the "--" terminator are never options
+//
+TEST(TestParser, Terminator)
+{
+    using namespace cppargparse;
+    auto arg_parser = test::make_arg_parser(test::parse_cmdargs("-- -v -v"), "TestParser");
+
+    const auto verbose = arg_parser.add_arg("-v", "--verbose");
+
+    ASSERT_FALSE(arg_parser.get_flag(verbose));
+    ASSERT_EQ(size_t(0), arg_parser.count(verbose));
+    ASSERT_TRUE(arg_parser.get_all<std::string>(verbose).empty());
+
+    // Option values end at the terminator
+    arg_parser.reset("--files a b -- c --cache -v --no-cache");
+
+    const auto files = arg_parser.add_arg("--files");
+    const auto cache = arg_parser.add_bool("--cache");
+
+    ASSERT_EQ((std::vector<std::string> {"a", "b"}), arg_parser.get_option<std::vector<std::string>>(files));
+    ASSERT_FALSE(arg_parser.get_flag(cache));
+    ASSERT_EQ(size_t(0), arg_parser.count(cache));
+    ASSERT_EQ(size_t(0), arg_parser.count(verbose));
+}
+
+
+//
+// reset()
+//
+TEST(TestParser, Reset)
+{
+    using namespace cppargparse;
+    parser::ArgumentParser arg_parser("-t 3 -I a -I b --verbose -x", "TestParser");
+
+    const auto t = arg_parser.add_arg("-t", "--time");
+    const auto include = arg_parser.add_arg("-I", "--include");
+    const auto verbose = arg_parser.add_arg("-v", "--verbose");
+
+    ASSERT_EQ(3, arg_parser.get_option<int>(t));
+    ASSERT_EQ(size_t(2), arg_parser.count(include));
+
+    // Shorter command lines reuse the storage of the previous one
+    const auto buffer = arg_parser.m_buffer.data();
+    const auto cmd = arg_parser.m_cmd.data();
+    const auto positions = arg_parser.m_cmdargs.at(1).positions().data();
+
+    arg_parser.reset("-I c --time=7");
+
+    ASSERT_EQ(buffer, arg_parser.m_buffer.data());
+    ASSERT_EQ(cmd, arg_parser.m_cmd.data());
+    ASSERT_EQ(positions, arg_parser.m_cmdargs.at(1).positions().data());
+
+    ASSERT_EQ(7, arg_parser.get_option<int>(t));
+    ASSERT_EQ(std::vector<std::string> {"c"}, arg_parser.get_all<std::string>(include));
+    ASSERT_FALSE(arg_parser.get_flag(verbose));
+    ASSERT_EQ(size_t(0), arg_parser.count(verbose));
+
+
+    // argc/argv
+    std::vector<char *> argv = test::parse_cmdargs("-vv -t 9");
+    arg_parser.reset(static_cast<int>(argv.size()), argv.data());
+
+    for (const char *arg : argv)
+    {
+        delete[] arg;
+    }
+
+    ASSERT_EQ(9, arg_parser.get_option<int>(t));
+    ASSERT_EQ(size_t(2), arg_parser.count(verbose));
+    ASSERT_ERROR(arg_parser.get_option<std::string>(include), errors::CommandLineArgumentError);
+}
+
+
+//
+// get_positional()
+//
+TEST(TestParser, GetPositional)
+{
+    using namespace cppargparse;
+    parser::ArgumentParser arg_parser("input.txt", "TestParser");
+
+    const auto input = arg_parser.add_positional("The input file");
+    ASSERT_EQ("input.txt", arg_parser.get_positional<std::string>(input));
+
+    arg_parser.reset("");
+    ASSERT_ERROR(arg_parser.get_positional<std::string>(input), errors::CommandLineArgumentError);
+
+    arg_parser.reset("output.txt");
+    ASSERT_EQ("output.txt", arg_parser.get_positional<std::string>(input));
+
+    // Positional arguments registered before an option stay in front of it
+    parser::ArgumentParser anchored("in.txt -t 3", "TestParser");
+    const auto file = anchored.add_positional();
+    const auto time = anchored.add_arg("-t");
+
+    anchored.reset("in.txt -t 3");
+    ASSERT_EQ("in.txt", anchored.get_positional<std::string>(file));
+    ASSERT_EQ(3, anchored.get_option<int>(time));
+}
+
+
+//
+// validate()
+//
+TEST(TestParser, Validate)
+{
+    using namespace cppargparse;
+    parser::ArgumentParser arg_parser("x -t abc -n 3 -n y", "TestParser");
+
+    const auto count = arg_parser.add_positional("The count");
+    const auto time = arg_parser.add_arg("-t", "--time");
+    const auto number = arg_parser.add_arg("-n");
+    const auto required = arg_parser.add_arg("-r");
+    const auto optional = arg_parser.add_arg("-o");
+
+    arg_parser.expect<int>(count);
+    arg_parser.expect<int>(time);
+    arg_parser.expect<int>(number);
+    arg_parser.expect<int>(required, true);
+    arg_parser.expect<int>(optional);
+
+    // Every problem is reported in a single sweep
+    const auto diagnostics = arg_parser.validate();
+    ASSERT_EQ(size_t(4), diagnostics.size());
+
+    ASSERT_EQ(errors::ErrorCode::InvalidValue, diagnostics[0].code);
+    ASSERT_EQ(size_t(0), diagnostics[0].token);
+    ASSERT_TRUE(diagnostics[0].positional);
+
+    ASSERT_EQ(errors::ErrorCode::InvalidValue, diagnostics[1].code);
+    ASSERT_EQ(size_t(2), diagnostics[1].token);
+    ASSERT_EQ(time.index(), diagnostics[1].argument);
+
+    ASSERT_EQ(errors::ErrorCode::InvalidValue, diagnostics[2].code);
+    ASSERT_EQ(size_t(6), diagnostics[2].token);
+    ASSERT_EQ(number.index(), diagnostics[2].argument);
+
+    ASSERT_EQ(errors::ErrorCode::ArgumentNotFound, diagnostics[3].code);
+    ASSERT_EQ(size_t(7), diagnostics[3].token);
+    ASSERT_EQ(required.index(), diagnostics[3].argument);
+
+    ASSERT_EQ("Couldn't convert \"x\" to type <int32_t> (token 0)", arg_parser.describe(diagnostics[0]));
+    ASSERT_EQ("Couldn't convert \"y\" to type <int32_t> (token 6)", arg_parser.describe(diagnostics[2]));
+    ASSERT_EQ("Cannot find argument: -r", arg_parser.describe(diagnostics[3]));
+
+    // The positional argument stays in front of the options it was registered before
+    arg_parser.reset("5 -t 1 -n 2 -r 3 -o 4");
+    ASSERT_TRUE(arg_parser.validate().empty());
+    ASSERT_EQ(5, arg_parser.get_positional<int>(count));
+
+    arg_parser.reset("-t 1 -n 2 -r 3 -o 4");
+    ASSERT_EQ(size_t(1), arg_parser.validate().size());
+}
+
+
+//
+// Structured errors
+//
+TEST(TestParser, ErrorPayload)
+{
+    using namespace cppargparse;
+    parser::ArgumentParser arg_parser("-t abc -s", "TestParser");
+
+    const auto time = arg_parser.add_arg("-t");
+    const auto size = arg_parser.add_arg("-s");
+
+    const auto invalid = test::catch_error([&]() { arg_parser.get_option<int>(time); });
+    ASSERT_EQ(errors::ErrorCode::InvalidValue, invalid.code());
+    ASSERT_EQ(size_t(1), invalid.payload().token);
+    ASSERT_STREQ("int32_t", invalid.payload().expected_type);
+    ASSERT_STREQ("abc", invalid.payload().subject);
+    ASSERT_STREQ("Error: Couldn't convert \"abc\" to type <int32_t> (token 1)", invalid.what());
+
+    const auto missing = test::catch_error([&]() { arg_parser.get_option<std::string>(size); });
+    ASSERT_STREQ("Error: Missing value of type <std::string> (token 3)", missing.what());
+
+    const auto not_found = test::catch_error([&]() { arg_parser.get_option<int>(arg_parser.add_arg("--a-rather-long-option-name-to-be-truncated")); });
+    ASSERT_EQ(errors::ErrorCode::ArgumentNotFound, not_found.code());
+    ASSERT_STREQ("Error: Cannot find argument: --a-rather-long-option-name-...", not_found.what());
+
+    const auto syntax = test::catch_error([&]() { parser::ArgumentParser("-t \"open", "TestParser"); });
+    ASSERT_EQ(errors::ErrorCode::SyntaxError, syntax.code());
+    ASSERT_EQ(size_t(1), syntax.payload().token);
+    ASSERT_STREQ("Error: Unterminated quote: \"open", syntax.what());
+
+    const errors::CommandLineSyntaxError syntax_error("Unterminated single quote");
+    ASSERT_EQ(errors::ErrorCode::SyntaxError, syntax_error.code());
+    ASSERT_STREQ("Error: Unterminated single quote", syntax_error.what());
+
+    const std::runtime_error &runtime_error = invalid;
+    ASSERT_STREQ(invalid.what(), runtime_error.what());
+}
+
+
+//
+// capture() returns the first error, with and without exceptions
+//
+TEST(TestParser, CaptureFirstError)
+{
+    using namespace cppargparse;
+
+    const auto code = errors::capture([]()
+    {
+        errors::raise<errors::CommandLineArgumentError>(
+                    errors::make_payload(errors::ErrorCode::ArgumentNotFound, 0, 0, nullptr, "-t"));
+        errors::raise<errors::CommandLineOptionError>(
+                    errors::make_payload(errors::ErrorCode::InvalidValue, 1, 0, "int32_t", "x"));
+    });
+
+    ASSERT_EQ(errors::ErrorCode::ArgumentNotFound, code);
+
+#if defined(CPPARGPARSE_NO_EXCEPTIONS)
+    // Without exceptions, converting carries on after the first invalid value, which is still the one reported
+    parser::ArgumentParser arg_parser("-p x y", "TestParser");
+    const auto pair = arg_parser.add_arg("-p");
+
+    errors::ErrorPayload first {};
+
+    ASSERT_EQ(errors::ErrorCode::InvalidValue, errors::capture([&]()
+    {
+        arg_parser.get_option<std::pair<int, int>>(pair);
+        first = errors::last_error();
+    }));
+
+    ASSERT_EQ(size_t(1), first.token);
+    ASSERT_STREQ("x", first.subject);
+#endif
+}
+
+
+#if defined(CPPARGPARSE_NO_EXCEPTIONS)
+//
+// Error handler without exceptions
+//
+size_t handled_errors = 0;
+
+void count_error(const cppargparse::errors::ErrorPayload &)
+{
+    ++handled_errors;
+}
+
+
+TEST(TestParser, ErrorHandler)
+{
+    using namespace cppargparse;
+    parser::ArgumentParser arg_parser("-t abc", "TestParser");
+
+    const auto time = arg_parser.add_arg("-t");
+    const auto previous = errors::set_error_handler(&count_error);
+
+    handled_errors = 0;
+    ASSERT_EQ(0, arg_parser.get_option<int>(time));
+    ASSERT_EQ(size_t(1), handled_errors);
+    ASSERT_EQ(errors::ErrorCode::InvalidValue, errors::last_error().code);
+
+    // Errors turned into default values or error codes don't reach the handler
+    errors::clear_error();
+    ASSERT_EQ(4, arg_parser.get_option<int>(time, 4));
+    ASSERT_EQ(size_t(1), handled_errors);
+    ASSERT_EQ(errors::ErrorCode::None, errors::last_error().code);
+
+    errors::set_error_handler(previous);
+}
+#endif
+
+
+//
+// std::pmr memory resource
+//
+TEST(TestParser, MemoryResource)
+{
+    using namespace cppargparse;
+
+    const std::pmr::vector<int> expected {1, 2, 3};
+
+    // Any allocation outside of the arenas fails, argument handles use the default memory resource
+    std::array<std::byte, 1024> handle_storage;
+    std::pmr::monotonic_buffer_resource handle_arena(handle_storage.data(), handle_storage.size(), std::pmr::null_memory_resource());
+    std::pmr::memory_resource *default_resource = std::pmr::set_default_resource(&handle_arena);
+    const test::ScopeExit restore([&]() { std::pmr::set_default_resource(default_resource); });
+
+    std::optional<cmd::CommandLineArgument> handle;
+
+    {
+        std::array<std::byte, 4096> storage;
+        std::pmr::monotonic_buffer_resource arena(storage.data(), storage.size(), std::pmr::null_memory_resource());
+
+        parser::ArgumentParser arg_parser("-t 3 -s 1 2 3 -v -v", "TestParser", &arena);
+
+        const auto t = arg_parser.add_arg("-t", "--time");
+        const auto s = arg_parser.add_arg("-s", "--seq");
+        const auto v = arg_parser.add_arg("-v", "--verbose");
+
+        ASSERT_EQ(&arena, arg_parser.resource());
+        ASSERT_EQ(&arena, arg_parser.m_cmdargs.front().positions().get_allocator().resource());
+        ASSERT_EQ(&handle_arena, v.positions().get_allocator().resource());
+        ASSERT_EQ(3, arg_parser.get_option<int>(t));
+        ASSERT_EQ(size_t(2), arg_parser.count(v));
+
+        const auto seq = arg_parser.get_option<std::pmr::vector<int>>(s);
+        ASSERT_EQ(&arena, seq.get_allocator().resource());
+        ASSERT_EQ(expected, seq);
+
+        const auto seq_list = arg_parser.get_option<std::pmr::list<int>>(s);
+        ASSERT_EQ(&arena, seq_list.get_allocator().resource());
+
+        arg_parser.reset("-t 4");
+        ASSERT_EQ(4, arg_parser.get_option<int>(t));
+
+        const parser::ArgumentParser copy(arg_parser);
+        ASSERT_EQ(&arena, copy.resource());
+
+        handle.emplace(v);
+    }
+
+    // The handle outlives the parser and its arena
+    ASSERT_EQ("--verbose", handle->id_alt());
+    ASSERT_EQ(size_t(2), handle->positions().size());
+}
+
+
+//
+// usage()
+//
+TEST(TestParser, Usage)
+{
+    using namespace cppargparse;
+    auto arg_parser = test::make_arg_parser(test::parse_cmdargs("-t 3"), "TestParser");
+
+    arg_parser.add_help();
+    arg_parser.add_arg("-t", "--time", "The time...");
+
+    const std::string expected =
+            "Usage: TestParser\n"
+            "\n"
+            "  -h|--help   Display this information\n"
+            "  -t|--time   The time...\n";
+
+    ASSERT_EQ(expected, arg_parser.usage());
+    ASSERT_EQ(1u, arg_parser.m_usages.count(0));
+
+    // The cached usage string is returned without a copy
+    ASSERT_EQ(&arg_parser.usage(), &arg_parser.usage());
+
+    // Adding an argument invalidates the cached usage string
+    arg_parser.add_arg("-x");
+    ASSERT_TRUE(arg_parser.m_usages.empty());
+
+    const std::string expected_x = expected + "  -x          \n";
+    ASSERT_EQ(expected_x, arg_parser.usage());
+
+    std::string written;
+    arg_parser.write_usage(std::back_inserter(written));
+    ASSERT_EQ(expected_x, written);
+}
+
+
+//
+// usage(<width>)
+//
+TEST(TestParser, UsageWidth)
+{
+    using namespace cppargparse;
+    auto arg_parser = test::make_arg_parser(test::parse_cmdargs("-t 3"), "TestParser");
+
+    arg_parser.add_arg("-t", "--time", "The time to wait before giving up on the connection");
+    arg_parser.add_arg("-ü", "--grüße", "Grüße an alle");
+    arg_parser.add_arg("-n", "--名前", "名前を入力してください 名前");
+
+    // Columns are aligned by display width, not by byte count
+    const std::string expected =
+            "Usage: TestParser\n"
+            "\n"
+            "  -t|--time    The time to wait before giving up on the connection\n"
+            "  -ü|--grüße   Grüße an alle\n"
+            "  -n|--名前    名前を入力してください 名前\n";
+
+    ASSERT_EQ(expected, arg_parser.usage());
+    ASSERT_EQ(expected, arg_parser.usage(80));
+
+    const std::string expected_wrapped =
+            "Usage: TestParser\n"
+            "\n"
+            "  -t|--time    The time to wait before\n"
+            "               giving up on the\n"
+            "               connection\n"
+            "  -ü|--grüße   Grüße an alle\n"
+            "  -n|--名前    名前を入力してください\n"
+            "               名前\n";
+
+    ASSERT_EQ(expected_wrapped, arg_parser.usage(40));
+    ASSERT_EQ(3u, arg_parser.m_usages.size());
+
+    // Too narrow to leave room for the descriptions
+    ASSERT_EQ(expected, arg_parser.usage(20));
+
+    // Concurrent calls render every width once
+    arg_parser.add_arg("-x");
+    std::vector<std::thread> threads;
+
+    for (size_t width = 30; width < 38; ++width)
+    {
+        threads.emplace_back([&arg_parser, width]() { arg_parser.usage(width % 4 + 40); });
+    }
+
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    ASSERT_EQ(4u, arg_parser.m_usages.size());
+}
+
+
+//
+// write_usage(<fd>)
+//
+TEST(TestParser, WriteUsage)
+{
+    using namespace cppargparse;
+    auto arg_parser = test::make_arg_parser(test::parse_cmdargs("-t 3"), "TestParser");
+
+    arg_parser.add_help();
+
+    int fds[2];
+    ASSERT_EQ(0, pipe(fds));
+    ASSERT_TRUE(arg_parser.write_usage(fds[1]));
+    close(fds[1]);
+
+    std::string written(1024, '\0');
+    written.resize(static_cast<size_t>(read(fds[0], &written[0], written.size())));
+    close(fds[0]);
+
+    ASSERT_EQ(arg_parser.usage(), written);
+    ASSERT_FALSE(arg_parser.write_usage(fds[1]));
+}
+
+
+//
+// add_choice()
+//
+enum class Color
+{
+    Red,
+    Green
+};
+
+CPPARGPARSE_ENUM_ARGUMENT(Color, {"red", Color::Red}, {"green", Color::Green});
+
+
+TEST(TestParser, UsageChoice)
+{
+    using namespace cppargparse;
+    auto arg_parser = test::make_arg_parser(test::parse_cmdargs("-c green"), "TestParser");
+
+    const auto color = arg_parser.add_choice<Color>("-c", "--color", "The color");
+    arg_parser.add_choice<Color>("-b");
+
+    const std::string expected =
+            "Usage: TestParser\n"
+            "\n"
+            "  -c|--color   The color (red|green)\n"
+            "  -b           red|green\n";
+
+    ASSERT_EQ(expected, arg_parser.usage());
+    ASSERT_EQ(Color::Green, arg_parser.get_option<Color>(color));
+}
+
+
 
 //
 // ----- Callback API -----
@@ -298,8 +911,8 @@ TEST(TestParser, AddArgWithCallback1)
 
     arg_parser.with<int>("-t", &check_t_is_4);
 
-    ASSERT_THROW(arg_parser.with<int>("-p", &check_t_is_4), errors::CommandLineArgumentError);
-    ASSERT_THROW(arg_parser.with<int>("-x", &check_t_is_4), errors::CommandLineOptionError);
+    ASSERT_ERROR(arg_parser.with<int>("-p", &check_t_is_4), errors::CommandLineArgumentError);
+    ASSERT_ERROR(arg_parser.with<int>("-x", &check_t_is_4), errors::CommandLineOptionError);
 }
 
 
@@ -313,8 +926,8 @@ TEST(TestParser, AddArgWithCallback2)
 
     arg_parser.with<int>("-t", "--time", &check_t_is_4);
 
-    ASSERT_THROW(arg_parser.with<int>("-p", "--productnum", &check_t_is_4), errors::CommandLineArgumentError);
-    ASSERT_THROW(arg_parser.with<int>("-x", "--existence", &check_t_is_4), errors::CommandLineOptionError);
+    ASSERT_ERROR(arg_parser.with<int>("-p", "--productnum", &check_t_is_4), errors::CommandLineArgumentError);
+    ASSERT_ERROR(arg_parser.with<int>("-x", "--existence", &check_t_is_4), errors::CommandLineOptionError);
 }
 
 
@@ -328,8 +941,8 @@ TEST(TestParser, AddArgWithCallback3)
 
     arg_parser.with<int>("-t", "--time", "The time it takes for...", &check_t_is_4);
 
-    ASSERT_THROW(arg_parser.with<int>("-p", "--productnum", "Some product number", &check_t_is_4), errors::CommandLineArgumentError);
-    ASSERT_THROW(arg_parser.with<int>("-x", "--existence", "Some philosophical description", &check_t_is_4), errors::CommandLineOptionError);
+    ASSERT_ERROR(arg_parser.with<int>("-p", "--productnum", "Some product number", &check_t_is_4), errors::CommandLineArgumentError);
+    ASSERT_ERROR(arg_parser.with<int>("-x", "--existence", "Some philosophical description", &check_t_is_4), errors::CommandLineOptionError);
 }
 
 
@@ -0,0 +1,81 @@
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <cppargparse/split.h>
+
+
+//
+// find()
+//
+TEST(TestSplit, Find)
+{
+    using namespace cppargparse;
+
+    ASSERT_EQ(std::string_view::npos, split::find("", ','));
+    ASSERT_EQ(1u, split::find("1,2", ','));
+    ASSERT_EQ(3u, split::find("1,2,3", ',', 2));
+    ASSERT_EQ(std::string_view::npos, split::find("1,2", ',', 2));
+
+    // Every position of the SIMD, SWAR and scalar parts
+    for (size_t size = 1; size < 40; ++size)
+    {
+        for (size_t position = 0; position < size; ++position)
+        {
+            std::string text(size, 'x');
+            text[position] = ';';
+
+            ASSERT_EQ(position, split::find(text, ';'));
+            ASSERT_EQ(std::string_view::npos, split::find(text, ';', position + 1));
+        }
+    }
+}
+
+
+//
+// count()
+//
+TEST(TestSplit, Count)
+{
+    using namespace cppargparse;
+
+    ASSERT_EQ(0u, split::count("", ','));
+    ASSERT_EQ(0u, split::count("0.5", ','));
+    ASSERT_EQ(2u, split::count("1,2,3", ','));
+
+    std::string text;
+
+    for (int i = 0; i < 100; ++i)
+    {
+        text += std::to_string(i) + ',';
+    }
+
+    ASSERT_EQ(100u, split::count(text, ','));
+
+    // Bytes with the high bit set must not be mistaken for delimiters
+    ASSERT_EQ(2u, split::count("\xAC\xAC,\xFF\x80,\xAC\xAC\xAC\xAC\xAC", ','));
+}
+
+
+//
+// for_each()
+//
+TEST(TestSplit, ForEach)
+{
+    using namespace cppargparse;
+
+    const auto values = [](const std::string_view &text, const char delimiter)
+    {
+        std::vector<std::string> parts;
+        split::for_each(text, delimiter, [&](const std::string_view &part) { parts.emplace_back(part); });
+
+        return parts;
+    };
+
+    ASSERT_EQ((std::vector<std::string> {"1", "22", "333"}), values("1,22,333", ','));
+    ASSERT_EQ((std::vector<std::string> {"", "a", ""}), values(",a,", ','));
+    ASSERT_EQ((std::vector<std::string> {""}), values("", ','));
+    ASSERT_EQ((std::vector<std::string> {"1,2"}), values("1,2", '\0'));
+}
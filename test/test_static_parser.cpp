@@ -0,0 +1,166 @@
+#include <array>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <cppargparse/cppargparse.h>
+
+#include "test_common.h"
+
+
+//
+// Options and flags
+//
+TEST(TestStaticParser, GetOption)
+{
+    using namespace cppargparse;
+    parser::StaticArgumentParser<4, 16> arg_parser;
+
+    const auto t = arg_parser.add_arg("-t", "--time");
+    const auto v = arg_parser.add_arg("-v", "--verbose");
+    const auto x = arg_parser.add_arg("-x");
+
+    std::string command_line("-t 60 -vv --verbose");
+    ASSERT_EQ(errors::ErrorCode::None, arg_parser.parse(command_line.data(), command_line.data() + command_line.size()));
+
+    int time = 0;
+    ASSERT_EQ(errors::ErrorCode::None, arg_parser.get_option(*t, time));
+    ASSERT_EQ(60, time);
+
+    ASSERT_TRUE(arg_parser.get_flag(*v));
+    ASSERT_EQ(size_t(3), arg_parser.count(*v));
+
+    ASSERT_FALSE(arg_parser.get_flag(*x));
+    ASSERT_EQ(errors::ErrorCode::ArgumentNotFound, arg_parser.get_option(*x, time));
+    ASSERT_EQ(60, time);
+}
+
+
+//
+// count() skips empty tokens and stops at the "--" terminator
+//
+TEST(TestStaticParser, Count)
+{
+    using namespace cppargparse;
+    parser::StaticArgumentParser<2, 16> arg_parser;
+
+    const auto name = arg_parser.add_arg("--name");
+    const auto v = arg_parser.add_arg("-v", "--verbose");
+
+    std::string command_line("--name \"\" x -v -- -v --verbose");
+    ASSERT_EQ(errors::ErrorCode::None, arg_parser.parse(command_line.data(), command_line.data() + command_line.size()));
+
+    ASSERT_EQ(size_t(1), arg_parser.count(*name));
+    ASSERT_EQ(size_t(1), arg_parser.count(*v));
+}
+
+
+//
+// Conversion errors
+//
+TEST(TestStaticParser, InvalidValue)
+{
+    using namespace cppargparse;
+    parser::StaticArgumentParser<2, 8> arg_parser;
+
+    const auto t = arg_parser.add_arg("-t", "--time");
+
+    std::vector<char *> argv = test::parse_cmdargs("--time=abc");
+    ASSERT_EQ(errors::ErrorCode::None, arg_parser.parse(static_cast<int>(argv.size()), argv.data()));
+
+    int time = 5;
+    ASSERT_EQ(errors::ErrorCode::InvalidValue, arg_parser.get_option(*t, time));
+    ASSERT_EQ(5, time);
+
+    for (const char *arg : argv)
+    {
+        delete[] arg;
+    }
+}
+
+
+//
+// Values into caller provided storage
+//
+TEST(TestStaticParser, GetOptionArray)
+{
+    using namespace cppargparse;
+    parser::StaticArgumentParser<2, 16> arg_parser;
+
+    const auto s = arg_parser.add_arg("-s", "--seq");
+    const auto t = arg_parser.add_arg("-t");
+
+    std::string command_line("-s 1 2 3 -t 4");
+    ASSERT_EQ(errors::ErrorCode::None, arg_parser.parse(command_line.data(), command_line.data() + command_line.size()));
+
+    std::array<int, 4> values {};
+    size_t size = 0;
+
+    ASSERT_EQ(errors::ErrorCode::None, arg_parser.get_option(*s, values, size));
+    ASSERT_EQ(size_t(3), size);
+    ASSERT_EQ((std::array<int, 4> {1, 2, 3, 0}), values);
+
+    // The trailing "-t" ends the sequence and keeps its own value
+    int t_value = 0;
+    ASSERT_EQ(errors::ErrorCode::None, arg_parser.get_option(*t, t_value));
+    ASSERT_EQ(4, t_value);
+
+    std::array<int, 2> small {};
+    ASSERT_EQ(errors::ErrorCode::CapacityExceeded, arg_parser.get_option(*s, small, size));
+    ASSERT_EQ(size_t(0), size);
+}
+
+
+TEST(TestStaticParser, GetOptionArrayDelimited)
+{
+    using namespace cppargparse;
+    parser::StaticArgumentParser<2, 16> arg_parser;
+
+    const auto s = arg_parser.add_arg("-s", "--seq");
+
+    std::string command_line("--seq=1,2 3");
+    ASSERT_EQ(errors::ErrorCode::None, arg_parser.parse(command_line.data(), command_line.data() + command_line.size()));
+
+    std::array<int, 3> values {};
+    size_t size = 0;
+
+    ASSERT_EQ(errors::ErrorCode::None, arg_parser.get_option(*s, values, size));
+    ASSERT_EQ(size_t(3), size);
+    ASSERT_EQ((std::array<int, 3> {1, 2, 3}), values);
+
+    std::array<int, 2> small {};
+    ASSERT_EQ(errors::ErrorCode::CapacityExceeded, arg_parser.get_option(*s, small, size));
+
+    command_line = "--seq 1,x,3";
+    ASSERT_EQ(errors::ErrorCode::None, arg_parser.parse(command_line.data(), command_line.data() + command_line.size()));
+    ASSERT_EQ(errors::ErrorCode::InvalidValue, arg_parser.get_option(*s, values, size));
+    ASSERT_EQ(size_t(1), size);
+}
+
+
+//
+// Capacity overflow
+//
+TEST(TestStaticParser, CapacityExceeded)
+{
+    using namespace cppargparse;
+    parser::StaticArgumentParser<1, 4> arg_parser;
+
+    const auto v = arg_parser.add_arg("-v");
+    ASSERT_NE(nullptr, v);
+    ASSERT_EQ(nullptr, arg_parser.add_arg("-x"));
+
+    // "-vvvvv" lexes into 5 tokens
+    std::string too_long("-vvvvv");
+    ASSERT_EQ(errors::ErrorCode::CapacityExceeded, arg_parser.parse(too_long.data(), too_long.data() + too_long.size()));
+    ASSERT_FALSE(arg_parser.get_flag(*v));
+
+    std::string fits("-vvvv");
+    ASSERT_EQ(errors::ErrorCode::None, arg_parser.parse(fits.data(), fits.data() + fits.size()));
+    ASSERT_EQ(size_t(4), arg_parser.count(*v));
+
+    std::string unterminated("-v 'x");
+    ASSERT_EQ(errors::ErrorCode::SyntaxError, arg_parser.parse(unterminated.data(), unterminated.data() + unterminated.size()));
+    ASSERT_FALSE(arg_parser.get_flag(*v));
+}
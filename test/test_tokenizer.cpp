@@ -0,0 +1,103 @@
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <cppargparse/cppargparse.h>
+
+#include "test_common.h"
+
+
+//
+// Tokenize a command string and return copies of the tokens
+//
+std::vector<std::string> tokenize(const std::string &command_line)
+{
+    std::string buffer(command_line);
+    const auto tokens = cppargparse::tokenizer::tokenize(buffer);
+
+    return {tokens.cbegin(), tokens.cend()};
+}
+
+
+//
+// Blanks
+//
+TEST(TestTokenizer, Blanks)
+{
+    const std::vector<std::string> expected {"-t", "3", "--name", "x"};
+
+    ASSERT_EQ(expected, tokenize("  -t 3\t--name\r\n x  "));
+    ASSERT_TRUE(tokenize("").empty());
+    ASSERT_TRUE(tokenize(" \t\n").empty());
+}
+
+
+//
+// Long tokens (vectorized scan)
+//
+TEST(TestTokenizer, LongTokens)
+{
+    const std::string path(100, 'p');
+    const std::vector<std::string> expected {path, "--" + path, path + " " + path};
+
+    ASSERT_EQ(expected, tokenize(path + " --" + path + " '" + path + " " + path + "'"));
+}
+
+
+//
+// Single quotes
+//
+TEST(TestTokenizer, SingleQuotes)
+{
+    const std::vector<std::string> expected {"My Name", "a\\b \"c\"", "", "x y"};
+
+    ASSERT_EQ(expected, tokenize("'My Name' 'a\\b \"c\"' '' x' 'y"));
+    ASSERT_ERROR(tokenize("'open"), cppargparse::errors::CommandLineSyntaxError);
+}
+
+
+//
+// Double quotes
+//
+TEST(TestTokenizer, DoubleQuotes)
+{
+    const std::vector<std::string> expected {"My Name", "a\\b \"c\" $ \\", "", "--name=a b"};
+
+    ASSERT_EQ(expected, tokenize("\"My Name\" \"a\\b \\\"c\\\" \\$ \\\\\" \"\" --name=\"a b\""));
+    ASSERT_EQ(std::vector<std::string> {"ab"}, tokenize("\"a\\\nb\""));
+    ASSERT_ERROR(tokenize("\"open"), cppargparse::errors::CommandLineSyntaxError);
+}
+
+
+//
+// Backslash escapes
+//
+TEST(TestTokenizer, Backslash)
+{
+    const std::vector<std::string> expected {"a b", "'", "\"", "ab", "end\\"};
+
+    ASSERT_EQ(expected, tokenize("a\\ b \\' \\\" a\\\nb end\\"));
+}
+
+
+//
+// Tokens are views into the buffer
+//
+TEST(TestTokenizer, Views)
+{
+    std::string buffer("-t 'a b' 3");
+    const auto tokens = cppargparse::tokenizer::tokenize(buffer);
+
+    ASSERT_EQ(size_t(3), tokens.size());
+
+    for (const auto &token : tokens)
+    {
+        ASSERT_GE(token.data(), buffer.data());
+        ASSERT_LE(token.data() + token.size(), buffer.data() + buffer.size());
+    }
+
+    ASSERT_EQ("a b", tokens.at(1));
+    ASSERT_EQ("3", tokens.at(2));
+}
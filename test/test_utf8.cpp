@@ -0,0 +1,58 @@
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <cppargparse/utf8.h>
+
+
+//
+// display_width(<ASCII>)
+//
+TEST(TestUtf8, DisplayWidthAscii)
+{
+    using namespace cppargparse;
+
+    ASSERT_EQ(0u, utf8::display_width(""));
+    ASSERT_EQ(6u, utf8::display_width("--help"));
+
+    // Longer than one SIMD chunk
+    const std::string text(100, 'x');
+    ASSERT_EQ(text.size(), utf8::display_width(text));
+    ASSERT_EQ(text.size(), utf8::ascii_prefix(text));
+}
+
+
+//
+// display_width(<UTF-8>)
+//
+TEST(TestUtf8, DisplayWidthUnicode)
+{
+    using namespace cppargparse;
+
+    // Two-byte characters occupy a single column
+    ASSERT_EQ(5u, utf8::display_width("Grüße"));
+
+    // CJK characters and emoji occupy two columns
+    ASSERT_EQ(4u, utf8::display_width("名前"));
+    ASSERT_EQ(2u, utf8::display_width("\xF0\x9F\x98\x80"));
+
+    // Combining marks occupy no column
+    ASSERT_EQ(1u, utf8::display_width("e\xCC\x81"));
+
+    // Non-ASCII characters after a long ASCII run
+    ASSERT_EQ(36u, utf8::display_width(std::string(32, '-') + "名前"));
+    ASSERT_EQ(32u, utf8::ascii_prefix(std::string(32, '-') + "名前"));
+}
+
+
+//
+// display_width(<invalid UTF-8>)
+//
+TEST(TestUtf8, DisplayWidthInvalid)
+{
+    using namespace cppargparse;
+
+    // Every invalid byte stands for a replacement character
+    ASSERT_EQ(2u, utf8::display_width("\xFF\xFE"));
+    ASSERT_EQ(3u, utf8::display_width("a\xE5\x90"));
+}